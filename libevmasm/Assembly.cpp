@@ -35,9 +35,13 @@
 
 #include <json/json.h>
 
-#include <fstream>
 #include <range/v3/algorithm/any_of.hpp>
 
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <thread>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -415,18 +419,55 @@ map<u256, u256> Assembly::optimiseInternal(
 )
 {
 	// Run optimisation for sub-assemblies.
+	OptimiserSettings settings = _settings;
+	// Disable creation mode for sub-assemblies.
+	settings.isCreation = false;
+	// The tags of a sub-assembly referenced here do not depend on the replacements
+	// of the other sub-assemblies, so they can all be determined up front.
+	vector<set<size_t>> referencedTags;
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		referencedTags.emplace_back(JumpdestRemover::referencedTags(m_items, subId));
+	vector<map<u256, u256>> subTagReplacements(m_subs.size());
+
+	if (settings.threads > 1 && m_subs.size() > 1 && subAssembliesAreDisjoint())
 	{
-		OptimiserSettings settings = _settings;
-		// Disable creation mode for sub-assemblies.
-		settings.isCreation = false;
-		map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(
-			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
-		);
-		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
+		// Each sub-assembly is only modified by the thread optimising it. Nested
+		// sub-assemblies are optimised serially to bound the number of threads.
+		OptimiserSettings subSettings = settings;
+		subSettings.threads = 1;
+		atomic<size_t> nextSub{0};
+		vector<exception_ptr> exceptions(m_subs.size());
+		auto worker = [&]() {
+			for (size_t subId = nextSub++; subId < m_subs.size(); subId = nextSub++)
+				try
+				{
+					subTagReplacements[subId] = m_subs[subId]->optimiseInternal(subSettings, move(referencedTags[subId]));
+				}
+				catch (...)
+				{
+					exceptions[subId] = current_exception();
+				}
+		};
+
+		vector<thread> threads;
+		for (size_t i = 1; i < min(settings.threads, m_subs.size()); ++i)
+			threads.emplace_back(worker);
+		worker();
+		for (thread& t: threads)
+			t.join();
+
+		// Report the error of the first sub-assembly, independently of the scheduling.
+		for (exception_ptr const& exception: exceptions)
+			if (exception)
+				rethrow_exception(exception);
 	}
+	else
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+			subTagReplacements[subId] = m_subs[subId]->optimiseInternal(settings, move(referencedTags[subId]));
+
+	// Apply the replacements (can be empty).
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements[subId], subId);
 
 	map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
@@ -549,6 +590,24 @@ map<u256, u256> Assembly::optimiseInternal(
 	return tagReplacements;
 }
 
+bool Assembly::subAssembliesAreDisjoint() const
+{
+	set<Assembly const*> seen;
+	// Collects @a _assembly and its nested sub-assemblies and returns false if one was seen before.
+	function<bool(Assembly const&)> collect = [&](Assembly const& _assembly) {
+		if (!seen.insert(&_assembly).second)
+			return false;
+		for (auto const& sub: _assembly.m_subs)
+			if (!collect(*sub))
+				return false;
+		return true;
+	};
+	for (auto const& sub: m_subs)
+		if (!collect(*sub))
+			return false;
+	return true;
+}
+
 LinkerObject const& Assembly::assemble() const
 {
 	assertThrow(!m_invalid, AssemblyException, "Attempted to assemble invalid Assembly object.");
@@ -125,6 +125,9 @@ public:
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = 200;
+		/// Number of threads that may be used to optimise independent sub-assemblies concurrently.
+		/// Does not influence the result.
+		size_t threads = 1;
 	};
 
 	/// Modify and return the current assembly such that creation and execution gas usage
@@ -164,6 +167,10 @@ protected:
 	/// returns the replaced tags. Also takes an argument containing the tags of this assembly
 	/// that are referenced in a super-assembly.
 	std::map<u256, u256> optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
+	/// @returns false if an assembly is reachable from more than one of the sub-assemblies
+	/// or more than once from the same one. Such sub-assemblies cannot be optimised concurrently,
+	/// since their optimisation would modify the shared assembly.
+	bool subAssembliesAreDisjoint() const;
 
 	unsigned bytesRequired(unsigned subTagSize) const;
 
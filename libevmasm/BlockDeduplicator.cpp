@@ -27,18 +27,61 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
-#include <functional>
-#include <set>
+#include <range/v3/view/reverse.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
 
 
+namespace
+{
+
+uint64_t constexpr fnvPrime = 1099511628211u;
+uint64_t constexpr fnvEmptyHash = 14695981039346656037u;
+
+void hash64(uint64_t& _hash, uint64_t _value)
+{
+	for (unsigned i = 0; i < 8; ++i)
+	{
+		_hash *= fnvPrime;
+		_hash ^= (_value >> (8 * i)) & 0xFF;
+	}
+}
+
+/// @returns a hash of @a _item that is equal for items that compare equal.
+uint64_t itemHash(AssemblyItem const& _item)
+{
+	uint64_t hash = fnvEmptyHash;
+	hash64(hash, static_cast<uint64_t>(_item.type()));
+	if (_item.type() == Operation)
+		hash64(hash, static_cast<uint64_t>(_item.instruction()));
+	else if (_item.type() == VerbatimBytecode)
+		for (uint8_t byte: _item.verbatimData())
+			hash64(hash, byte);
+	else
+		for (unsigned i = 0; i < 4; ++i)
+			hash64(hash, static_cast<uint64_t>((_item.data() >> (64 * i)) & u256(numeric_limits<uint64_t>::max())));
+	return hash;
+}
+
+/// @returns true if @a _item ends a block, i.e. the control flow does not continue
+/// to the next item in any branch.
+bool endsBlock(AssemblyItem const& _item)
+{
+	return SemanticInformation::altersControlFlow(_item) && _item != AssemblyItem{Instruction::JUMPI};
+}
+
+}
+
 bool BlockDeduplicator::deduplicate()
 {
-	// Compares indices based on the suffix that starts there, ignoring tags and stopping at
-	// opcodes that stop the control flow.
+	// Groups the blocks by the hash of their content, ignoring tags and stopping at
+	// opcodes that stop the control flow, and compares blocks with equal hashes.
 
 	// Virtual tag that signifies "the current block" and which is used to optimise loops.
 	// We abort if this virtual tag actually exists.
@@ -48,57 +91,154 @@ bool BlockDeduplicator::deduplicate()
 		std::count(m_items.cbegin(), m_items.cend(), pushSelf.pushTag())
 	)
 		return false;
+	uint64_t pushSelfHash = itemHash(pushSelf);
 
-	function<bool(size_t, size_t)> comparator = [&](size_t _i, size_t _j)
-	{
-		if (_i == _j)
-			return false;
-
-		// To compare recursive loops, we have to already unify PushTag opcodes of the
-		// block's own tag.
-		AssemblyItem pushFirstTag{pushSelf};
-		AssemblyItem pushSecondTag{pushSelf};
-
-		if (_i < m_items.size() && m_items.at(_i).type() == Tag)
-			pushFirstTag = m_items.at(_i).pushTag();
-		if (_j < m_items.size() && m_items.at(_j).type() == Tag)
-			pushSecondTag = m_items.at(_j).pushTag();
-
-		using diff_type = BlockIterator::difference_type;
-		BlockIterator first{m_items.begin() + diff_type(_i), m_items.end(), &pushFirstTag, &pushSelf};
-		BlockIterator second{m_items.begin() + diff_type(_j), m_items.end(), &pushSecondTag, &pushSelf};
-		BlockIterator end{m_items.end(), m_items.end()};
-
-		if (first != end && (*first).type() == Tag)
-			++first;
-		if (second != end && (*second).type() == Tag)
-			++second;
-
-		return std::lexicographical_compare(first, end, second, end);
-	};
+	computeHashes();
 
 	size_t iterations = 0;
 	for (; ; ++iterations)
 	{
-		//@todo this should probably be optimized.
-		set<size_t, function<bool(size_t, size_t)>> blocksSeen(comparator);
+		map<u256, vector<size_t>> pushTagPositions;
+		for (size_t i = 0; i < m_items.size(); ++i)
+			if (m_items[i].type() == PushTag)
+				pushTagPositions[m_items[i].data()].push_back(i);
+
+		// Maps block hashes to the first blocks with distinct content that have this hash.
+		unordered_map<uint64_t, vector<size_t>> blocksSeen;
 		for (size_t i = 0; i < m_items.size(); ++i)
 		{
-			if (m_items.at(i).type() != Tag)
+			if (m_items[i].type() != Tag)
 				continue;
-			auto it = blocksSeen.find(i);
-			if (it == blocksSeen.end())
-				blocksSeen.insert(i);
+			vector<size_t>& candidates = blocksSeen[blockHash(i, pushTagPositions, pushSelfHash)];
+			auto it = find_if(candidates.begin(), candidates.end(), [&](size_t _j) {
+				return blocksEqual(_j, i, pushSelf);
+			});
+			if (it == candidates.end())
+				candidates.push_back(i);
 			else
-				m_replacedTags[m_items.at(i).data()] = m_items.at(*it).data();
+				m_replacedTags[m_items[i].data()] = m_items[*it].data();
 		}
 
 		if (!applyTagReplacement(m_items, m_replacedTags))
 			break;
+		updateHashes();
 	}
 	return iterations > 0;
 }
 
+void BlockDeduplicator::computeHashes()
+{
+	size_t size = m_items.size();
+	m_itemHashes.resize(size);
+	for (size_t i = 0; i < size; ++i)
+		m_itemHashes[i] = itemHash(m_items[i]);
+
+	m_powers.resize(size + 1);
+	m_powers[0] = 1;
+	for (size_t i = 1; i <= size; ++i)
+		m_powers[i] = m_powers[i - 1] * fnvPrime;
+
+	m_blockEnds.assign(size + 1, size);
+	for (size_t i = size; i-- > 0;)
+		m_blockEnds[i] = endsBlock(m_items[i]) ? i : m_blockEnds[i + 1];
+
+	m_rollingHashes.assign(size + 1, 0);
+	m_remainingLengths.assign(size + 1, 0);
+	for (size_t pos = size; pos > 0;)
+		pos = rehashBlock(pos - 1);
+}
+
+void BlockDeduplicator::updateHashes()
+{
+	// Tag replacements only modify PushTag items.
+	vector<size_t> changed;
+	for (size_t i = 0; i < m_items.size(); ++i)
+		if (m_items[i].type() == PushTag)
+		{
+			uint64_t hash = itemHash(m_items[i]);
+			if (hash != m_itemHashes[i])
+			{
+				m_itemHashes[i] = hash;
+				changed.push_back(i);
+			}
+		}
+
+	size_t rehashedFrom = m_items.size();
+	for (size_t i: changed | ranges::views::reverse)
+		if (i < rehashedFrom)
+			rehashedFrom = rehashBlock(i);
+}
+
+size_t BlockDeduplicator::rehashBlock(size_t _pos)
+{
+	for (size_t i = _pos; ; --i)
+	{
+		if (m_items[i].type() == Tag)
+		{
+			m_rollingHashes[i] = m_rollingHashes[i + 1];
+			m_remainingLengths[i] = m_remainingLengths[i + 1];
+		}
+		else if (m_blockEnds[i] == i)
+		{
+			m_rollingHashes[i] = m_itemHashes[i];
+			m_remainingLengths[i] = 1;
+		}
+		else
+		{
+			m_rollingHashes[i] = m_itemHashes[i] + fnvPrime * m_rollingHashes[i + 1];
+			m_remainingLengths[i] = m_remainingLengths[i + 1] + 1;
+		}
+		if (i == 0 || m_blockEnds[i - 1] == i - 1)
+			return i;
+	}
+}
+
+uint64_t BlockDeduplicator::blockHash(
+	size_t _tagPos,
+	map<u256, vector<size_t>> const& _pushTagPositions,
+	uint64_t _pushSelfHash
+) const
+{
+	size_t begin = _tagPos + 1;
+	uint64_t hash = m_rollingHashes[begin];
+
+	// To find recursive loops, PushTag operations of the block's own tag
+	// are hashed like the virtual tag.
+	auto positions = _pushTagPositions.find(m_items[_tagPos].data());
+	if (positions != _pushTagPositions.end())
+		for (
+			auto it = lower_bound(positions->second.begin(), positions->second.end(), begin);
+			it != positions->second.end() && *it <= m_blockEnds[begin];
+			++it
+		)
+			hash += (_pushSelfHash - m_itemHashes[*it]) * m_powers[m_remainingLengths[begin] - m_remainingLengths[*it]];
+
+	return hash;
+}
+
+bool BlockDeduplicator::blocksEqual(size_t _i, size_t _j, AssemblyItem const& _pushSelf) const
+{
+	if (m_remainingLengths[_i + 1] != m_remainingLengths[_j + 1])
+		return false;
+
+	// To compare recursive loops, we have to already unify PushTag opcodes of the
+	// block's own tag.
+	AssemblyItem pushFirstTag = m_items.at(_i).pushTag();
+	AssemblyItem pushSecondTag = m_items.at(_j).pushTag();
+
+	using diff_type = BlockIterator::difference_type;
+	BlockIterator first{m_items.begin() + diff_type(_i), m_items.end(), &pushFirstTag, &_pushSelf};
+	BlockIterator second{m_items.begin() + diff_type(_j), m_items.end(), &pushSecondTag, &_pushSelf};
+	BlockIterator end{m_items.end(), m_items.end()};
+
+	if (first != end && (*first).type() == Tag)
+		++first;
+	if (second != end && (*second).type() == Tag)
+		++second;
+
+	return std::equal(first, end, second, end);
+}
+
 bool BlockDeduplicator::applyTagReplacement(
 	AssemblyItems& _items,
 	map<u256, u256> const& _replacements,
@@ -40,6 +40,10 @@ using AssemblyItems = std::vector<AssemblyItem>;
 /**
  * Optimizer class to be used to unify blocks that share content.
  * Modifies the passed vector in place.
+ *
+ * Blocks are grouped by a rolling hash of their content, so that only blocks with
+ * equal hashes have to be compared. The hashes of blocks that are not affected
+ * by a tag replacement are kept across the rounds of deduplicate().
  */
 class BlockDeduplicator
 {
@@ -61,6 +65,26 @@ public:
 	);
 
 private:
+	/// Computes the hashes of all items and the rolling hashes of all positions.
+	void computeHashes();
+	/// Recomputes the hashes of the PushTag items and the rolling hashes of the blocks
+	/// containing one whose hash changed.
+	void updateHashes();
+	/// Recomputes the rolling hashes of position @a _pos and the positions in front of it,
+	/// down to the start of the block containing it.
+	/// @returns the first position that was recomputed.
+	size_t rehashBlock(size_t _pos);
+	/// @returns the hash of the content of the block starting at the tag at position @a _tagPos,
+	/// where push operations of the tag itself (found in @a _pushTagPositions) are replaced
+	/// by an item with hash @a _pushSelfHash.
+	uint64_t blockHash(
+		size_t _tagPos,
+		std::map<u256, std::vector<size_t>> const& _pushTagPositions,
+		uint64_t _pushSelfHash
+	) const;
+	/// @returns true if the blocks starting at the tags at positions @a _i and @a _j have equal content.
+	bool blocksEqual(size_t _i, size_t _j, AssemblyItem const& _pushSelf) const;
+
 	/// Iterator that skips tags and skips to the end if (all branches of) the control
 	/// flow does not continue to the next instruction.
 	/// If the arguments are supplied to the constructor, replaces items on the fly.
@@ -86,6 +110,18 @@ private:
 
 	std::map<u256, u256> m_replacedTags;
 	AssemblyItems& m_items;
+	/// Hash of each item.
+	std::vector<uint64_t> m_itemHashes;
+	/// For each position, the rolling hash of the block content (ignoring tags) that starts there.
+	/// Has an additional element for the end of the items.
+	std::vector<uint64_t> m_rollingHashes;
+	/// For each position, the number of items (ignoring tags) until the end of the block.
+	std::vector<size_t> m_remainingLengths;
+	/// For each position, the position of the item that ends the block, or the number of items.
+	/// Tag replacements do not change these.
+	std::vector<size_t> m_blockEnds;
+	/// Powers of the base of the rolling hash.
+	std::vector<uint64_t> m_powers;
 };
 
 }
@@ -25,6 +25,8 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -81,6 +83,9 @@ struct ApplyRule<Method, 1>
 template <class Method, size_t WindowSize>
 struct SimplePeepholeOptimizerMethod
 {
+	/// Number of items the method looks at to decide whether it applies.
+	static size_t constexpr windowSize = WindowSize;
+
 	static bool apply(OptimiserState& _state)
 	{
 		if (
@@ -337,6 +342,10 @@ struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd, 3>
 /// Removes everything after a JUMP (or similar) until the next JUMPDEST.
 struct UnreachableCode
 {
+	/// The method removes items up to the next tag, but only the first two items
+	/// decide whether it applies.
+	static size_t constexpr windowSize = 2;
+
 	static bool apply(OptimiserState& _state)
 	{
 		auto it = _state.items.begin() + static_cast<ptrdiff_t>(_state.i);
@@ -367,43 +376,77 @@ struct UnreachableCode
 	}
 };
 
-void applyMethods(OptimiserState&)
+template <typename... Methods>
+struct MethodList
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
-}
+	/// Applies the first method that matches at the current position.
+	static bool apply(OptimiserState& _state)
+	{
+		return (Methods::apply(_state) || ...);
+	}
+
+	/// Maximal number of items any of the methods looks at.
+	static size_t constexpr maxWindowSize = std::max({Methods::windowSize...});
+};
 
-template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+using PeepholeMethods = MethodList<
+	PushPop, OpPop, DoublePush, DoubleSwap, CommutativeSwap, SwapComparison,
+	DupSwap, IsZeroIsZeroJumpI, JumpToNext, UnreachableCode,
+	TagConjunctions, TruthyAnd
+>;
+
+size_t numberOfPops(AssemblyItems::const_iterator _begin, AssemblyItems::const_iterator _end)
 {
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
+	return static_cast<size_t>(std::count(_begin, _end, Instruction::POP));
 }
 
-size_t numberOfPops(AssemblyItems const& _items)
+size_t codeSize(AssemblyItems::const_iterator _begin, AssemblyItems::const_iterator _end)
 {
-	return static_cast<size_t>(std::count(_items.begin(), _items.end(), Instruction::POP));
+	size_t size = 0;
+	for (auto it = _begin; it != _end; ++it)
+		size += it->bytesRequired(3);
+	return size;
 }
 
 }
 
 bool PeepholeOptimiser::optimise()
 {
-	OptimiserState state {m_items, 0, std::back_inserter(m_optimisedItems)};
+	// The items in front of the first change of the previous round were not changed
+	// by any method and only the windows that reach into that change can see a different
+	// input now. Since this round starts out the same way, those items are not visited again.
+	size_t const start = m_unchangedItems;
+	m_optimisedItems.clear();
+	OptimiserState state {m_items, start, std::back_inserter(m_optimisedItems)};
+	optional<size_t> firstChange;
 	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(), OpPop(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
-			DupSwap(), IsZeroIsZeroJumpI(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
-		);
-	if (m_optimisedItems.size() < m_items.size() || (
-		m_optimisedItems.size() == m_items.size() && (
-			evmasm::bytesRequired(m_optimisedItems, 3) < evmasm::bytesRequired(m_items, 3) ||
-			numberOfPops(m_optimisedItems) > numberOfPops(m_items)
+	{
+		size_t position = start + m_optimisedItems.size();
+		if (PeepholeMethods::apply(state))
+		{
+			if (!firstChange)
+				firstChange = position;
+		}
+		else
+			Identity::apply(state);
+	}
+	if (!firstChange)
+		return false;
+
+	// Only the items starting at ``start`` differ, so it suffices to compare those.
+	auto const unoptimisedBegin = m_items.cbegin() + static_cast<ptrdiff_t>(start);
+	size_t const unoptimisedSize = m_items.size() - start;
+	if (m_optimisedItems.size() < unoptimisedSize || (
+		m_optimisedItems.size() == unoptimisedSize && (
+			codeSize(m_optimisedItems.cbegin(), m_optimisedItems.cend()) < codeSize(unoptimisedBegin, m_items.cend()) ||
+			numberOfPops(m_optimisedItems.cbegin(), m_optimisedItems.cend()) > numberOfPops(unoptimisedBegin, m_items.cend())
 		)
 	))
 	{
-		m_items = std::move(m_optimisedItems);
+		m_items.erase(unoptimisedBegin, m_items.cend());
+		move(m_optimisedItems.begin(), m_optimisedItems.end(), back_inserter(m_items));
+		size_t constexpr lookBehind = PeepholeMethods::maxWindowSize - 1;
+		m_unchangedItems = *firstChange >= lookBehind ? *firstChange - lookBehind : 0;
 		return true;
 	}
 	else
@@ -44,11 +44,16 @@ public:
 	explicit PeepholeOptimiser(AssemblyItems& _items): m_items(_items) {}
 	virtual ~PeepholeOptimiser() = default;
 
+	/// Performs one round of optimisation.
+	/// Subsequent rounds assume that the items were not modified in between.
+	/// @returns true if the items were changed.
 	bool optimise();
 
 private:
 	AssemblyItems& m_items;
 	AssemblyItems m_optimisedItems;
+	/// Number of items at the start that the next round will not change.
+	size_t m_unchangedItems = 0;
 };
 
 }
@@ -33,6 +33,8 @@
 #undef _GLIBCXX_PERMIT_BACKWARD_HASH
 #endif
 
+#include <unordered_map>
+
 namespace solidity::smtutil
 {
 
@@ -55,20 +57,32 @@ public:
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
 
+	/// @returns the name and version of the solver.
+	static std::string version();
+
+	// CVC4 "basic resources" limit.
+	// This is used to make the runs more deterministic and platform/machine independent.
+	// The tests start failing for CVC4 with less than 6000,
+	// so using double that.
+	static int const resourceLimit = 12000;
+
 private:
+	/// Translates the expression to CVC4. Subterms shared between several places
+	/// of the expression (identified by their shared argument list) are only
+	/// translated once.
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
+	/// Translations of compound subterms, keyed by ExpressionArguments::id().
+	/// They are not kept across calls to toCVC4Expr, so that the terms CVC4 sees
+	/// do not depend on earlier queries.
+	using Translations = std::unordered_map<void const*, std::pair<std::string, CVC4::Expr>>;
+	CVC4::Expr toCVC4Expr(Expression const& _expr, Translations& _translations);
+	CVC4::Expr translate(Expression const& _expr, std::vector<CVC4::Expr> const& _arguments);
 	CVC4::Type cvc4Sort(Sort const& _sort);
 	std::vector<CVC4::Type> cvc4Sort(std::vector<SortPointer> const& _sorts);
 
 	CVC4::ExprManager m_context;
 	CVC4::SmtEngine m_solver;
 	std::map<std::string, CVC4::Expr> m_variables;
-
-	// CVC4 "basic resources" limit.
-	// This is used to make the runs more deterministic and platform/machine independent.
-	// The tests start failing for CVC4 with less than 6000,
-	// so using double that.
-	static int const resourceLimit = 12000;
 };
 
 }
@@ -0,0 +1,187 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for answers of SMT solvers that persists across compiler runs.
+ */
+
+#include <libsmtutil/QueryCache.h>
+
+#include <libsolutil/Keccak256.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::smtutil;
+
+namespace
+{
+
+/// Names are prefixed with their length, so that they can contain any character.
+string quoted(string const& _name)
+{
+	return to_string(_name.size()) + ":" + _name;
+}
+
+}
+
+void QueryText::appendSort(Sort const& _sort)
+{
+	switch (_sort.kind)
+	{
+	case Kind::Int:
+		m_text += dynamic_cast<IntSort const&>(_sort).isSigned ? "SInt" : "Int";
+		break;
+	case Kind::Bool:
+		m_text += "Bool";
+		break;
+	case Kind::BitVector:
+		m_text += "(BitVec " + to_string(dynamic_cast<BitVectorSort const&>(_sort).size) + ")";
+		break;
+	case Kind::Function:
+	{
+		auto const& functionSort = dynamic_cast<FunctionSort const&>(_sort);
+		m_text += "(Function";
+		for (auto const& domain: functionSort.domain)
+		{
+			m_text += " ";
+			appendSort(*domain);
+		}
+		m_text += " ";
+		appendSort(*functionSort.codomain);
+		m_text += ")";
+		break;
+	}
+	case Kind::Array:
+	{
+		auto const& arraySort = dynamic_cast<ArraySort const&>(_sort);
+		m_text += "(Array ";
+		appendSort(*arraySort.domain);
+		m_text += " ";
+		appendSort(*arraySort.range);
+		m_text += ")";
+		break;
+	}
+	case Kind::Sort:
+		m_text += "(Sort ";
+		appendSort(*dynamic_cast<SortSort const&>(_sort).inner);
+		m_text += ")";
+		break;
+	case Kind::Tuple:
+	{
+		auto const& tupleSort = dynamic_cast<TupleSort const&>(_sort);
+		m_text += "(Tuple " + quoted(tupleSort.name);
+		for (size_t i = 0; i < tupleSort.members.size(); ++i)
+		{
+			m_text += " " + quoted(tupleSort.members.at(i)) + " ";
+			appendSort(*tupleSort.components.at(i));
+		}
+		m_text += ")";
+		break;
+	}
+	}
+}
+
+void QueryText::appendExpression(Expression const& _expr)
+{
+	if (_expr.arguments.empty())
+	{
+		m_symbols.insert(_expr.name);
+		m_text += quoted(_expr.name) + " " + sortText(_expr.sort);
+		return;
+	}
+
+	if (
+		auto it = m_subterms.find(_expr.arguments.id());
+		it != m_subterms.end() && it->second.second == _expr.name
+	)
+	{
+		m_text += "#" + to_string(it->second.first);
+		return;
+	}
+
+	m_symbols.insert(_expr.name);
+	m_text += "(" + quoted(_expr.name) + " " + sortText(_expr.sort);
+	for (Expression const& argument: _expr.arguments)
+	{
+		m_text += " ";
+		appendExpression(argument);
+	}
+	m_text += ")";
+	m_subterms.emplace(_expr.arguments.id(), make_pair(m_subterms.size(), _expr.name));
+}
+
+void QueryText::appendDeclaration(string const& _name, Sort const& _sort)
+{
+	m_text += "(declare " + quoted(_name) + " ";
+	appendSort(_sort);
+	m_text += ")\n";
+}
+
+string const& QueryText::sortText(SortPointer const& _sort)
+{
+	smtAssert(_sort, "");
+	auto it = m_sortTexts.find(_sort.get());
+	if (it != m_sortTexts.end())
+		return it->second;
+
+	QueryText text;
+	text.appendSort(*_sort);
+	return m_sortTexts.emplace(_sort.get(), text.text()).first->second;
+}
+
+h256 QueryCache::key(string const& _solver, string const& _query)
+{
+	return keccak256(quoted(_solver) + _query);
+}
+
+optional<pair<CheckResult, vector<string>>> QueryCache::load(h256 const& _key) const
+{
+	optional<Json::Value> entry = m_load(_key);
+	if (!entry || !entry->isObject() || !(*entry)["result"].isString() || !(*entry)["values"].isArray())
+		return nullopt;
+
+	CheckResult result;
+	if ((*entry)["result"].asString() == "sat")
+		result = CheckResult::SATISFIABLE;
+	else if ((*entry)["result"].asString() == "unsat")
+		result = CheckResult::UNSATISFIABLE;
+	else
+		return nullopt;
+
+	vector<string> values;
+	for (auto const& value: (*entry)["values"])
+	{
+		if (!value.isString())
+			return nullopt;
+		values.push_back(value.asString());
+	}
+	return make_pair(result, move(values));
+}
+
+void QueryCache::store(h256 const& _key, CheckResult _result, vector<string> const& _values) const
+{
+	if (_result != CheckResult::SATISFIABLE && _result != CheckResult::UNSATISFIABLE)
+		return;
+
+	Json::Value entry(Json::objectValue);
+	entry["result"] = _result == CheckResult::SATISFIABLE ? "sat" : "unsat";
+	entry["values"] = Json::arrayValue;
+	for (string const& value: _values)
+		entry["values"].append(value);
+	m_store(_key, entry);
+}
@@ -0,0 +1,104 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for answers of SMT solvers that persists across compiler runs.
+ */
+
+#pragma once
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <json/json.h>
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace solidity::smtutil
+{
+
+/**
+ * Canonical textual representation of the expressions and sorts of a query,
+ * used to compute cache keys.
+ *
+ * Subterms that are shared (see ExpressionArguments::id()) are written once and
+ * referred to by the index of their first occurrence afterwards, so the size of
+ * the text is linear in the number of distinct subterms.
+ */
+class QueryText
+{
+public:
+	void append(std::string const& _text) { m_text += _text; }
+	void appendSort(Sort const& _sort);
+	void appendExpression(Expression const& _expr);
+	void appendDeclaration(std::string const& _name, Sort const& _sort);
+
+	/// @returns the names of all constants and functions used by the appended expressions.
+	std::set<std::string> const& symbols() const { return m_symbols; }
+	std::string const& text() const { return m_text; }
+
+private:
+	std::string const& sortText(SortPointer const& _sort);
+
+	std::string m_text;
+	std::set<std::string> m_symbols;
+	/// Index of the first occurrence of a compound subterm and its name, by argument list.
+	std::map<void const*, std::pair<size_t, std::string>> m_subterms;
+	std::map<Sort const*, std::string> m_sortTexts;
+};
+
+/**
+ * Stores the answers of SMT and Horn solvers, so that queries that were solved in an
+ * earlier compiler run do not have to be solved again.
+ *
+ * The cache does not access any storage itself, entries are loaded and stored through
+ * the given callbacks. Keys cover the text of the whole query and an identifier of the
+ * solver that includes its version and configuration. Only SATISFIABLE and UNSATISFIABLE
+ * answers are stored, since other answers can depend on the machine or on the queries
+ * the solver saw before.
+ */
+class QueryCache
+{
+public:
+	using LoadCallback = std::function<std::optional<Json::Value>(util::h256 const&)>;
+	using StoreCallback = std::function<void(util::h256 const&, Json::Value const&)>;
+
+	QueryCache(LoadCallback _load, StoreCallback _store):
+		m_load(std::move(_load)), m_store(std::move(_store)) {}
+
+	/// @returns the key of the query @a _query sent to the solver identified by @a _solver.
+	static util::h256 key(std::string const& _solver, std::string const& _query);
+
+	/// @returns the answer and the values of the evaluated expressions stored for @a _key.
+	std::optional<std::pair<CheckResult, std::vector<std::string>>> load(util::h256 const& _key) const;
+	/// Stores the answer @a _result with the values @a _values under @a _key
+	/// if it is SATISFIABLE or UNSATISFIABLE.
+	void store(util::h256 const& _key, CheckResult _result, std::vector<std::string> const& _values) const;
+
+private:
+	LoadCallback m_load;
+	StoreCallback m_store;
+};
+
+}
@@ -36,18 +36,36 @@ SMTPortfolio::SMTPortfolio(
 	map<h256, string> _smtlib2Responses,
 	frontend::ReadCallback::Callback _smtCallback,
 	[[maybe_unused]] SMTSolverChoice _enabledSolvers,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	shared_ptr<QueryCache> _queryCache
 ):
-	SolverInterface(_queryTimeout)
+	SolverInterface(_queryTimeout),
+	m_smtlib2Responses(_smtlib2Responses),
+	m_smtCallback(_smtCallback),
+	m_enabledSolvers(_enabledSolvers),
+	m_queryCache(move(_queryCache))
 {
+	string const limit = m_queryTimeout ? "timeout " + to_string(*m_queryTimeout) : "";
 	m_solvers.emplace_back(make_unique<SMTLib2Interface>(move(_smtlib2Responses), move(_smtCallback), m_queryTimeout));
+	// Answers of the SMT-LIB2 interface are not cached, they are handled through its query responses.
+	m_solverIdentifiers.emplace_back();
 #ifdef HAVE_Z3
 	if (_enabledSolvers.z3 && Z3Interface::available())
+	{
 		m_solvers.emplace_back(make_unique<Z3Interface>(m_queryTimeout));
+		m_solverIdentifiers.emplace_back(
+			Z3Interface::version() + " " + (limit.empty() ? "rlimit " + to_string(Z3Interface::resourceLimit) : limit)
+		);
+	}
 #endif
 #ifdef HAVE_CVC4
 	if (_enabledSolvers.cvc4)
+	{
 		m_solvers.emplace_back(make_unique<CVC4Interface>(m_queryTimeout));
+		m_solverIdentifiers.emplace_back(
+			CVC4Interface::version() + " " + (limit.empty() ? "rlimit " + to_string(CVC4Interface::resourceLimit) : limit)
+		);
+	}
 #endif
 }
 
@@ -55,18 +73,27 @@ void SMTPortfolio::reset()
 {
 	for (auto const& s: m_solvers)
 		s->reset();
+	m_declarations.clear();
+	m_assertions.assign(1, {});
 }
 
 void SMTPortfolio::push()
 {
 	for (auto const& s: m_solvers)
 		s->push();
+	if (m_queryCache)
+		m_assertions.emplace_back();
 }
 
 void SMTPortfolio::pop()
 {
 	for (auto const& s: m_solvers)
 		s->pop();
+	if (m_queryCache)
+	{
+		smtAssert(m_assertions.size() > 1, "");
+		m_assertions.pop_back();
+	}
 }
 
 void SMTPortfolio::declareVariable(string const& _name, SortPointer const& _sort)
@@ -74,12 +101,15 @@ void SMTPortfolio::declareVariable(string const& _name, SortPointer const& _sort
 	smtAssert(_sort, "");
 	for (auto const& s: m_solvers)
 		s->declareVariable(_name, _sort);
+	m_declarations.emplace_back(_name, _sort);
 }
 
 void SMTPortfolio::addAssertion(Expression const& _expr)
 {
 	for (auto const& s: m_solvers)
 		s->addAssertion(_expr);
+	if (m_queryCache)
+		m_assertions.back().push_back(_expr);
 }
 
 /*
@@ -111,16 +141,34 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * If there is a query cache, Z3 and CVC4 are only asked if the cache does not
+ * contain their answer to the same query yet.
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	optional<string> query;
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
-	for (auto const& s: m_solvers)
+	for (size_t i = 0; i < m_solvers.size(); ++i)
 	{
 		CheckResult result;
 		vector<string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
+		if (m_queryCache && !m_solverIdentifiers.at(i).empty())
+		{
+			if (!query)
+				query = queryText(_expressionsToEvaluate);
+			h256 key = QueryCache::key(m_solverIdentifiers.at(i), *query);
+			if (auto cached = m_queryCache->load(key))
+				tie(result, values) = move(*cached);
+			else
+			{
+				tie(result, values) = m_solvers.at(i)->check(_expressionsToEvaluate);
+				m_queryCache->store(key, result, values);
+			}
+		}
+		else
+			tie(result, values) = m_solvers.at(i)->check(_expressionsToEvaluate);
 		if (solverAnswered(result))
 		{
 			if (!solverAnswered(lastResult))
@@ -149,7 +197,45 @@ vector<string> SMTPortfolio::unhandledQueries()
 	return m_solvers.front()->unhandledQueries();
 }
 
+unique_ptr<SMTPortfolio> SMTPortfolio::cloneDeclarations() const
+{
+	auto portfolio = make_unique<SMTPortfolio>(m_smtlib2Responses, m_smtCallback, m_enabledSolvers, m_queryTimeout, m_queryCache);
+	for (auto const& [name, sort]: m_declarations)
+		portfolio->declareVariable(name, sort);
+	return portfolio;
+}
+
 bool SMTPortfolio::solverAnswered(CheckResult result)
 {
 	return result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE;
 }
+
+string SMTPortfolio::queryText(vector<Expression> const& _expressionsToEvaluate) const
+{
+	QueryText body;
+	for (auto const& level: m_assertions)
+		for (Expression const& assertion: level)
+		{
+			body.append("(assert ");
+			body.appendExpression(assertion);
+			body.append(")\n");
+		}
+	for (Expression const& expression: _expressionsToEvaluate)
+	{
+		body.append("(eval ");
+		body.appendExpression(expression);
+		body.append(")\n");
+	}
+
+	// Only the declarations of used variables are part of the query, so that the key
+	// does not depend on unrelated parts of the contract. Later declarations replace
+	// earlier ones with the same name.
+	map<string, SortPointer> declarations;
+	for (auto const& [name, sort]: m_declarations)
+		if (body.symbols().count(name))
+			declarations[name] = sort;
+	QueryText header;
+	for (auto const& [name, sort]: declarations)
+		header.appendDeclaration(name, *sort);
+	return header.text() + body.text();
+}
@@ -19,11 +19,13 @@
 #pragma once
 
 
+#include <libsmtutil/QueryCache.h>
 #include <libsmtutil/SolverInterface.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolutil/FixedHash.h>
 
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace solidity::smtutil
@@ -34,6 +36,8 @@ namespace solidity::smtutil
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
  * to SMT queries.
+ * If a query cache is given, the answers of Z3 and CVC4 are looked up
+ * in and stored to the cache.
  */
 class SMTPortfolio: public SolverInterface
 {
@@ -46,7 +50,8 @@ public:
 		std::map<util::h256, std::string> _smtlib2Responses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
 		SMTSolverChoice _enabledSolvers = SMTSolverChoice::All(),
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		std::shared_ptr<QueryCache> _queryCache = nullptr
 	);
 
 	void reset() override;
@@ -62,12 +67,34 @@ public:
 
 	std::vector<std::string> unhandledQueries() override;
 	size_t solvers() override { return m_solvers.size(); }
+
+	/// @returns a new portfolio with the same configuration and the same declared variables,
+	/// but without any assertions. The new portfolio can be used concurrently with this one
+	/// as long as the SMT callback can be called concurrently.
+	std::unique_ptr<SMTPortfolio> cloneDeclarations() const;
 private:
 	static bool solverAnswered(CheckResult result);
 
+	/// @returns the canonical text of the current query, consisting of the declarations
+	/// of the used variables, all assertions and the expressions to evaluate.
+	std::string queryText(std::vector<Expression> const& _expressionsToEvaluate) const;
+
+	std::map<util::h256, std::string> m_smtlib2Responses;
+	frontend::ReadCallback::Callback m_smtCallback;
+	SMTSolverChoice m_enabledSolvers;
+
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
+	/// Identifiers of the solvers in m_solvers, including their version and configuration,
+	/// used in query cache keys. Empty for solvers whose answers are not cached.
+	std::vector<std::string> m_solverIdentifiers;
+
+	std::shared_ptr<QueryCache> m_queryCache;
+
+	/// Variables declared since the last reset, in order of declaration.
+	std::vector<std::pair<std::string, SortPointer>> m_declarations;
 
-	std::vector<Expression> m_assertions;
+	/// Assertions for each level of push, only recorded if there is a query cache.
+	std::vector<std::vector<Expression>> m_assertions = std::vector<std::vector<Expression>>(1);
 };
 
 }
@@ -53,6 +53,38 @@ enum class CheckResult
 	SATISFIABLE, UNSATISFIABLE, UNKNOWN, CONFLICTING, ERROR
 };
 
+class Expression;
+
+/// Immutable list of the arguments of an Expression.
+/// Copies share the same storage, so copying an expression does not copy its
+/// subterms and subterms used in several places are stored only once.
+class ExpressionArguments
+{
+public:
+	ExpressionArguments() = default;
+	ExpressionArguments(std::vector<Expression> _arguments);
+
+	bool empty() const { return !m_arguments; }
+	size_t size() const;
+	Expression const& at(size_t _index) const;
+	Expression const& operator[](size_t _index) const;
+	Expression const& front() const;
+	Expression const& back() const;
+	std::vector<Expression>::const_iterator begin() const;
+	std::vector<Expression>::const_iterator end() const;
+
+	operator std::vector<Expression> const&() const { return list(); }
+
+	/// @returns a key that identifies the shared storage. It is equal for copies
+	/// of the same list and null for an empty list.
+	void const* id() const { return m_arguments.get(); }
+
+private:
+	std::vector<Expression> const& list() const;
+
+	std::shared_ptr<std::vector<Expression> const> m_arguments;
+};
+
 /// C++ representation of an SMTLIB2 expression.
 class Expression
 {
@@ -366,7 +398,7 @@ public:
 	}
 
 	std::string name;
-	std::vector<Expression> arguments;
+	ExpressionArguments arguments;
 	SortPointer sort;
 
 private:
@@ -382,6 +414,26 @@ private:
 		Expression(std::move(_name), std::vector<Expression>{std::move(_arg1), std::move(_arg2)}, _kind) {}
 };
 
+inline ExpressionArguments::ExpressionArguments(std::vector<Expression> _arguments)
+{
+	if (!_arguments.empty())
+		m_arguments = std::make_shared<std::vector<Expression> const>(std::move(_arguments));
+}
+
+inline std::vector<Expression> const& ExpressionArguments::list() const
+{
+	static std::vector<Expression> const emptyList;
+	return m_arguments ? *m_arguments : emptyList;
+}
+
+inline size_t ExpressionArguments::size() const { return list().size(); }
+inline Expression const& ExpressionArguments::at(size_t _index) const { return list().at(_index); }
+inline Expression const& ExpressionArguments::operator[](size_t _index) const { return list()[_index]; }
+inline Expression const& ExpressionArguments::front() const { return list().front(); }
+inline Expression const& ExpressionArguments::back() const { return list().back(); }
+inline std::vector<Expression>::const_iterator ExpressionArguments::begin() const { return list().begin(); }
+inline std::vector<Expression>::const_iterator ExpressionArguments::end() const { return list().end(); }
+
 DEV_SIMPLE_EXCEPTION(SolverError);
 
 class SolverInterface
@@ -19,6 +19,7 @@
 #include <libsmtutil/Z3CHCInterface.h>
 
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/Keccak256.h>
 
 #include <set>
 #include <stack>
@@ -27,11 +28,12 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::smtutil;
 
-Z3CHCInterface::Z3CHCInterface(optional<unsigned> _queryTimeout):
+Z3CHCInterface::Z3CHCInterface(optional<unsigned> _queryTimeout, shared_ptr<QueryCache> _queryCache):
 	CHCSolverInterface(_queryTimeout),
 	m_z3Interface(make_unique<Z3Interface>(m_queryTimeout)),
 	m_context(m_z3Interface->context()),
-	m_solver(*m_context)
+	m_solver(*m_context),
+	m_queryCache(move(_queryCache))
 {
 	Z3_get_version(
 		&get<0>(m_version),
@@ -55,15 +57,38 @@ void Z3CHCInterface::declareVariable(string const& _name, SortPointer const& _so
 {
 	smtAssert(_sort, "");
 	m_z3Interface->declareVariable(_name, _sort);
+	if (m_queryCache)
+	{
+		QueryText text;
+		text.appendDeclaration(_name, *_sort);
+		addToHornSystem(text);
+	}
 }
 
 void Z3CHCInterface::registerRelation(Expression const& _expr)
 {
 	m_solver.register_relation(m_z3Interface->functions().at(_expr.name));
+	if (m_queryCache)
+	{
+		QueryText text;
+		text.append("(relation ");
+		text.appendExpression(_expr);
+		text.append(")\n");
+		addToHornSystem(text);
+	}
 }
 
 void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 {
+	if (m_queryCache)
+	{
+		QueryText text;
+		text.append("(rule " + to_string(_name.size()) + ":" + _name + " ");
+		text.appendExpression(_expr);
+		text.append(")\n");
+		addToHornSystem(text);
+	}
+
 	z3::expr rule = m_z3Interface->toZ3Expr(_expr);
 	if (m_z3Interface->constants().empty())
 		m_solver.add_rule(rule, m_context->str_symbol(_name.c_str()));
@@ -79,6 +104,26 @@ void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 
 pair<CheckResult, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression const& _expr)
 {
+	// Only unsatisfiable answers are cached, since the counterexample graph
+	// of a satisfiable answer cannot be restored.
+	optional<util::h256> cacheKey;
+	if (m_queryCache)
+	{
+		QueryText text;
+		text.append(m_hornSystem.hex());
+		text.append(m_preProcessing ? "(query " : "(query-without-preprocessing ");
+		text.appendExpression(_expr);
+		text.append(")\n");
+		string solver = Z3Interface::version() + " spacer " + (
+			m_queryTimeout ?
+			"timeout " + to_string(*m_queryTimeout) :
+			"rlimit " + to_string(Z3Interface::resourceLimit)
+		);
+		cacheKey = QueryCache::key(solver, text.text());
+		if (auto cached = m_queryCache->load(*cacheKey); cached && cached->first == CheckResult::UNSATISFIABLE)
+			return {CheckResult::UNSATISFIABLE, {}};
+	}
+
 	CheckResult result;
 	try
 	{
@@ -100,6 +145,8 @@ pair<CheckResult, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression
 		case z3::check_result::unsat:
 		{
 			result = CheckResult::UNSATISFIABLE;
+			if (cacheKey)
+				m_queryCache->store(*cacheKey, result, {});
 			// TODO retrieve invariants.
 			break;
 		}
@@ -149,6 +196,12 @@ void Z3CHCInterface::setSpacerOptions(bool _preProcessing)
 	p.set("fp.xform.inline_eager", _preProcessing);
 
 	m_solver.set(p);
+	m_preProcessing = _preProcessing;
+}
+
+void Z3CHCInterface::addToHornSystem(QueryText const& _text)
+{
+	m_hornSystem = util::keccak256(m_hornSystem.hex() + _text.text());
 }
 
 /**
@@ -23,8 +23,11 @@
 #pragma once
 
 #include <libsmtutil/CHCSolverInterface.h>
+#include <libsmtutil/QueryCache.h>
 #include <libsmtutil/Z3Interface.h>
 
+#include <libsolutil/FixedHash.h>
+
 #include <tuple>
 #include <vector>
 
@@ -34,7 +37,12 @@ namespace solidity::smtutil
 class Z3CHCInterface: public CHCSolverInterface
 {
 public:
-	Z3CHCInterface(std::optional<unsigned> _queryTimeout = {});
+	/// If @a _queryCache is given, unsatisfiable queries (safe targets) are looked up
+	/// in and stored to the cache.
+	Z3CHCInterface(
+		std::optional<unsigned> _queryTimeout = {},
+		std::shared_ptr<QueryCache> _queryCache = nullptr
+	);
 
 	/// Forwards variable declaration to Z3Interface.
 	void declareVariable(std::string const& _name, SortPointer const& _sort) override;
@@ -59,6 +67,9 @@ private:
 	/// @returns the arguments of @a _predicate.
 	std::vector<std::string> arguments(z3::expr const& _predicate);
 
+	/// Adds @a _text to the digest of the Horn system, if there is a query cache.
+	void addToHornSystem(QueryText const& _text);
+
 	// Used to handle variables.
 	std::unique_ptr<Z3Interface> m_z3Interface;
 
@@ -67,6 +78,11 @@ private:
 	z3::fixedpoint m_solver;
 
 	std::tuple<unsigned, unsigned, unsigned, unsigned> m_version = std::tuple(0, 0, 0, 0);
+
+	std::shared_ptr<QueryCache> m_queryCache;
+	/// Hash of all declarations, relations and rules added so far, in order.
+	util::h256 m_hornSystem;
+	bool m_preProcessing = true;
 };
 
 }
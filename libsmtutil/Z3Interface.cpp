@@ -38,6 +38,11 @@ bool Z3Interface::available()
 #endif
 }
 
+string Z3Interface::version()
+{
+	return Z3_get_full_version();
+}
+
 Z3Interface::Z3Interface(std::optional<unsigned> _queryTimeout):
 	SolverInterface(_queryTimeout),
 	m_solver(m_context)
@@ -141,23 +146,45 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 {
-	if (_expr.arguments.empty() && m_constants.count(_expr.name))
-		return m_constants.at(_expr.name);
+	Translations translations;
+	return toZ3Expr(_expr, translations);
+}
+
+z3::expr Z3Interface::toZ3Expr(Expression const& _expr, Translations& _translations)
+{
+	if (_expr.arguments.empty())
+	{
+		if (m_constants.count(_expr.name))
+			return m_constants.at(_expr.name);
+		return translate(_expr, z3::expr_vector(m_context));
+	}
+
+	auto it = _translations.find(_expr.arguments.id());
+	if (it != _translations.end() && it->second.first == _expr.name)
+		return it->second.second;
+
 	z3::expr_vector arguments(m_context);
 	for (auto const& arg: _expr.arguments)
-		arguments.push_back(toZ3Expr(arg));
+		arguments.push_back(toZ3Expr(arg, _translations));
 
+	z3::expr result = translate(_expr, arguments);
+	_translations.insert_or_assign(_expr.arguments.id(), make_pair(_expr.name, result));
+	return result;
+}
+
+z3::expr Z3Interface::translate(Expression const& _expr, z3::expr_vector const& _arguments)
+{
 	try
 	{
 		string const& n = _expr.name;
 		if (m_functions.count(n))
-			return m_functions.at(n)(arguments);
+			return m_functions.at(n)(_arguments);
 		else if (m_constants.count(n))
 		{
-			smtAssert(arguments.empty(), "");
+			smtAssert(_arguments.empty(), "");
 			return m_constants.at(n);
 		}
-		else if (arguments.empty())
+		else if (_arguments.empty())
 		{
 			if (n == "true")
 				return m_context.bool_val(true);
@@ -182,83 +209,83 @@ z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 
 		smtAssert(_expr.hasCorrectArity(), "");
 		if (n == "ite")
-			return z3::ite(arguments[0], arguments[1], arguments[2]);
+			return z3::ite(_arguments[0], _arguments[1], _arguments[2]);
 		else if (n == "not")
-			return !arguments[0];
+			return !_arguments[0];
 		else if (n == "and")
-			return arguments[0] && arguments[1];
+			return _arguments[0] && _arguments[1];
 		else if (n == "or")
-			return arguments[0] || arguments[1];
+			return _arguments[0] || _arguments[1];
 		else if (n == "=>")
-			return z3::implies(arguments[0], arguments[1]);
+			return z3::implies(_arguments[0], _arguments[1]);
 		else if (n == "=")
-			return arguments[0] == arguments[1];
+			return _arguments[0] == _arguments[1];
 		else if (n == "<")
-			return arguments[0] < arguments[1];
+			return _arguments[0] < _arguments[1];
 		else if (n == "<=")
-			return arguments[0] <= arguments[1];
+			return _arguments[0] <= _arguments[1];
 		else if (n == ">")
-			return arguments[0] > arguments[1];
+			return _arguments[0] > _arguments[1];
 		else if (n == ">=")
-			return arguments[0] >= arguments[1];
+			return _arguments[0] >= _arguments[1];
 		else if (n == "+")
-			return arguments[0] + arguments[1];
+			return _arguments[0] + _arguments[1];
 		else if (n == "-")
-			return arguments[0] - arguments[1];
+			return _arguments[0] - _arguments[1];
 		else if (n == "*")
-			return arguments[0] * arguments[1];
+			return _arguments[0] * _arguments[1];
 		else if (n == "div")
-			return arguments[0] / arguments[1];
+			return _arguments[0] / _arguments[1];
 		else if (n == "mod")
-			return z3::mod(arguments[0], arguments[1]);
+			return z3::mod(_arguments[0], _arguments[1]);
 		else if (n == "bvnot")
-			return ~arguments[0];
+			return ~_arguments[0];
 		else if (n == "bvand")
-			return arguments[0] & arguments[1];
+			return _arguments[0] & _arguments[1];
 		else if (n == "bvor")
-			return arguments[0] | arguments[1];
+			return _arguments[0] | _arguments[1];
 		else if (n == "bvxor")
-			return arguments[0] ^ arguments[1];
+			return _arguments[0] ^ _arguments[1];
 		else if (n == "bvshl")
-			return z3::shl(arguments[0], arguments[1]);
+			return z3::shl(_arguments[0], _arguments[1]);
 		else if (n == "bvlshr")
-			return z3::lshr(arguments[0], arguments[1]);
+			return z3::lshr(_arguments[0], _arguments[1]);
 		else if (n == "bvashr")
-			return z3::ashr(arguments[0], arguments[1]);
+			return z3::ashr(_arguments[0], _arguments[1]);
 		else if (n == "int2bv")
 		{
 			size_t size = std::stoul(_expr.arguments[1].name);
-			return z3::int2bv(static_cast<unsigned>(size), arguments[0]);
+			return z3::int2bv(static_cast<unsigned>(size), _arguments[0]);
 		}
 		else if (n == "bv2int")
 		{
 			auto intSort = dynamic_pointer_cast<IntSort>(_expr.sort);
 			smtAssert(intSort, "");
-			return z3::bv2int(arguments[0], intSort->isSigned);
+			return z3::bv2int(_arguments[0], intSort->isSigned);
 		}
 		else if (n == "select")
-			return z3::select(arguments[0], arguments[1]);
+			return z3::select(_arguments[0], _arguments[1]);
 		else if (n == "store")
-			return z3::store(arguments[0], arguments[1], arguments[2]);
+			return z3::store(_arguments[0], _arguments[1], _arguments[2]);
 		else if (n == "const_array")
 		{
 			shared_ptr<SortSort> sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments[0].sort);
 			smtAssert(sortSort, "");
 			auto arraySort = dynamic_pointer_cast<ArraySort>(sortSort->inner);
 			smtAssert(arraySort && arraySort->domain, "");
-			return z3::const_array(z3Sort(*arraySort->domain), arguments[1]);
+			return z3::const_array(z3Sort(*arraySort->domain), _arguments[1]);
 		}
 		else if (n == "tuple_get")
 		{
 			size_t index = stoul(_expr.arguments[1].name);
-			return z3::func_decl(m_context, Z3_get_tuple_sort_field_decl(m_context, z3Sort(*_expr.arguments[0].sort), static_cast<unsigned>(index)))(arguments[0]);
+			return z3::func_decl(m_context, Z3_get_tuple_sort_field_decl(m_context, z3Sort(*_expr.arguments[0].sort), static_cast<unsigned>(index)))(_arguments[0]);
 		}
 		else if (n == "tuple_constructor")
 		{
 			auto constructor = z3::func_decl(m_context, Z3_get_tuple_sort_mk_decl(m_context, z3Sort(*_expr.sort)));
-			smtAssert(constructor.arity() == arguments.size(), "");
+			smtAssert(constructor.arity() == _arguments.size(), "");
 			z3::expr_vector args(m_context);
-			for (auto const& arg: arguments)
+			for (auto const& arg: _arguments)
 				args.push_back(arg);
 			return constructor(args);
 		}
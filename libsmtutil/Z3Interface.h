@@ -21,6 +21,8 @@
 #include <libsmtutil/SolverInterface.h>
 #include <z3++.h>
 
+#include <unordered_map>
+
 namespace solidity::smtutil
 {
 
@@ -34,6 +36,8 @@ public:
 	Z3Interface(std::optional<unsigned> _queryTimeout = {});
 
 	static bool available();
+	/// @returns the name and version of the solver.
+	static std::string version();
 
 	void reset() override;
 
@@ -45,6 +49,9 @@ public:
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
 
+	/// Translates the expression to Z3. Subterms shared between several places
+	/// of the expression (identified by their shared argument list) are only
+	/// translated once.
 	z3::expr toZ3Expr(Expression const& _expr);
 	smtutil::Expression fromZ3Expr(z3::expr const& _expr);
 
@@ -60,6 +67,13 @@ public:
 private:
 	void declareFunction(std::string const& _name, Sort const& _sort);
 
+	/// Translations of compound subterms, keyed by ExpressionArguments::id().
+	/// They are not kept across calls to toZ3Expr: keeping Z3 terms alive changes the
+	/// identifiers Z3 assigns to later terms and with them the heuristics of the solver.
+	using Translations = std::unordered_map<void const*, std::pair<std::string, z3::expr>>;
+	z3::expr toZ3Expr(Expression const& _expr, Translations& _translations);
+	z3::expr translate(Expression const& _expr, z3::expr_vector const& _arguments);
+
 	z3::sort z3Sort(Sort const& _sort);
 	z3::sort_vector z3Sort(std::vector<SortPointer> const& _sorts);
 	smtutil::SortPointer fromZ3Sort(z3::sort const& _sort);
@@ -24,11 +24,18 @@
 #include <libsolc/libsolc.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
-#include <libyul/YulString.h>
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstdlib>
+#include <deque>
 #include <list>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "license.h"
 
@@ -45,6 +52,15 @@ namespace
 // The strings in this list must not be resized after they have been added here (via solidity_alloc()), because
 // this may potentially change the pointer that was passed to the caller from solidity_alloc().
 static list<string> solidityAllocations;
+// Guards solidityAllocations, which is also accessed from the threads of compiler contexts.
+static mutex solidityAllocationsMutex;
+
+/// Adds @p _data to the list of allocations and returns a pointer to it.
+char* addAllocation(string _data)
+{
+	lock_guard<mutex> lock(solidityAllocationsMutex);
+	return solidityAllocations.emplace_back(move(_data)).data();
+}
 
 /// Find the equivalent to @p _data in the list of allocations of solidity_alloc(),
 /// removes it from the list and returns its value.
@@ -53,6 +69,7 @@ static list<string> solidityAllocations;
 /// on the caller-side and hence, will call abort() then.
 string takeOverAllocation(char const* _data)
 {
+	lock_guard<mutex> lock(solidityAllocationsMutex);
 	for (auto iter = begin(solidityAllocations); iter != end(solidityAllocations); ++iter)
 		if (iter->data() == _data)
 		{
@@ -114,6 +131,106 @@ string compile(string _input, CStyleReadFileCallback _readCallback, void* _readC
 
 }
 
+/// Compiler context of solidity_compiler_create().
+struct solidity_compiler
+{
+	explicit solidity_compiler(unsigned _threads)
+	{
+		try
+		{
+			for (unsigned i = 0; i < _threads; ++i)
+				workers.emplace_back([this]() { work(); });
+		}
+		catch (...)
+		{
+			stop();
+			throw;
+		}
+	}
+
+	~solidity_compiler() { stop(); }
+
+	/// Lets the workers finish the queued jobs and waits for them.
+	void stop()
+	{
+		{
+			lock_guard<mutex> lock(jobsMutex);
+			stopping = true;
+		}
+		jobSubmitted.notify_all();
+		for (thread& worker: workers)
+			worker.join();
+		workers.clear();
+	}
+
+	struct Job
+	{
+		string input;
+		CStyleReadFileCallback readCallback = nullptr;
+		void* readContext = nullptr;
+		optional<string> result;
+	};
+
+	/// Compiles queued jobs until the context is destroyed and the queue is empty.
+	void work()
+	{
+		unique_lock<mutex> lock(jobsMutex);
+		while (true)
+		{
+			jobSubmitted.wait(lock, [&]() { return stopping || !queue.empty(); });
+			if (queue.empty())
+				return;
+			Job& job = jobs.at(queue.front());
+			queue.pop_front();
+
+			lock.unlock();
+			string result = compile(move(job.input), job.readCallback, job.readContext);
+			lock.lock();
+
+			job.result = move(result);
+			jobFinished.notify_all();
+		}
+	}
+
+	/// Removes the job @a _job and returns its result if it has finished or if @a _wait is true.
+	char* takeResult(size_t _job, bool _wait)
+	{
+		unique_lock<mutex> lock(jobsMutex);
+		auto job = jobs.find(_job);
+		if (_wait)
+			// Looks the job up again, since another thread can retrieve it in the meantime.
+			jobFinished.wait(lock, [&]() {
+				job = jobs.find(_job);
+				return job == jobs.end() || job->second.result.has_value();
+			});
+		if (job == jobs.end() || !job->second.result)
+			return nullptr;
+
+		// The list node is allocated before the result is taken, so that the result is not
+		// lost if the allocation fails.
+		list<string> allocation(1);
+		allocation.front() = move(*job->second.result);
+		jobs.erase(job);
+		lock.unlock();
+
+		char* data = allocation.front().data();
+		lock_guard<mutex> allocationsLock(solidityAllocationsMutex);
+		solidityAllocations.splice(solidityAllocations.end(), allocation);
+		return data;
+	}
+
+	mutex jobsMutex;
+	condition_variable jobSubmitted;
+	condition_variable jobFinished;
+	/// Jobs by their identifier. Elements are not moved, so that workers can refer to them.
+	map<size_t, Job> jobs;
+	/// Identifiers of the jobs that have not been started yet.
+	deque<size_t> queue;
+	size_t nextJob = 1;
+	bool stopping = false;
+	vector<thread> workers;
+};
+
 extern "C"
 {
 extern char const* solidity_license() noexcept
@@ -129,14 +246,14 @@ extern char const* solidity_version() noexcept
 
 extern char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) noexcept
 {
-	return solidityAllocations.emplace_back(compile(_input, _readCallback, _readContext)).data();
+	return addAllocation(compile(_input, _readCallback, _readContext));
 }
 
 extern char* solidity_alloc(size_t _size) noexcept
 {
 	try
 	{
-		return solidityAllocations.emplace_back(_size, '\0').data();
+		return addAllocation(string(_size, '\0'));
 	}
 	catch (...)
 	{
@@ -152,9 +269,77 @@ extern void solidity_free(char* _data) noexcept
 
 extern void solidity_reset() noexcept
 {
-	// This is called right before each compilation, but not at the end, so additional memory
-	// can be freed here.
-	yul::YulStringRepository::reset();
+	// The YulStrings of a compilation are released when it ends, the global repository
+	// only holds the dialects, which are shared between compilations.
+	lock_guard<mutex> lock(solidityAllocationsMutex);
 	solidityAllocations.clear();
 }
+
+extern solidity_compiler* solidity_compiler_create(unsigned _threads) noexcept
+{
+	try
+	{
+		if (_threads == 0)
+			_threads = max(thread::hardware_concurrency(), 1u);
+		return new solidity_compiler(_threads);
+	}
+	catch (...)
+	{
+		// Most likely std::system_error because a thread could not be started.
+		return nullptr;
+	}
+}
+
+extern void solidity_compiler_destroy(solidity_compiler* _compiler) noexcept
+{
+	delete _compiler;
+}
+
+extern size_t solidity_compiler_submit(
+	solidity_compiler* _compiler,
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext
+) noexcept
+{
+	try
+	{
+		lock_guard<mutex> lock(_compiler->jobsMutex);
+		size_t job = _compiler->nextJob++;
+		_compiler->jobs[job] = {_input, _readCallback, _readContext, nullopt};
+		_compiler->queue.push_back(job);
+		_compiler->jobSubmitted.notify_one();
+		return job;
+	}
+	catch (...)
+	{
+		return 0;
+	}
+}
+
+extern char* solidity_compiler_poll(solidity_compiler* _compiler, size_t _job) noexcept
+{
+	try
+	{
+		return _compiler->takeResult(_job, false);
+	}
+	catch (...)
+	{
+		// Most likely std::bad_alloc, in which case the result can be retrieved again later.
+		return nullptr;
+	}
+}
+
+extern char* solidity_compiler_wait(solidity_compiler* _compiler, size_t _job) noexcept
+{
+	try
+	{
+		return _compiler->takeResult(_job, true);
+	}
+	catch (...)
+	{
+		// Most likely std::bad_alloc, in which case the result can be retrieved again later.
+		return nullptr;
+	}
+}
 }
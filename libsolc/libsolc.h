@@ -93,9 +93,56 @@ char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback,
 /// Frees up any allocated memory.
 ///
 /// NOTE: the pointer returned by solidity_compile as well as any other pointer retrieved via solidity_alloc()
-/// is invalid after calling this!
+/// is invalid after calling this! It must not be called while a compiler context created by
+/// solidity_compiler_create() is alive.
 void solidity_reset() SOLC_NOEXCEPT;
 
+/// Compiler context that runs independent "Standard Input JSON" jobs concurrently.
+///
+/// All functions operating on a context are safe to call from different threads at the same time.
+/// solidity_alloc() and solidity_free() are safe to call concurrently with them as well.
+typedef struct solidity_compiler solidity_compiler;
+
+/// Creates a compiler context that compiles the jobs submitted to it on @p _threads threads.
+///
+/// @param _threads The number of threads. If zero, one thread per hardware thread is used.
+///
+/// @returns A pointer to the context, which must be freed using solidity_compiler_destroy(),
+///          or NULL if it could not be created.
+solidity_compiler* solidity_compiler_create(unsigned _threads) SOLC_NOEXCEPT;
+
+/// Waits until all jobs of @p _compiler are finished and frees the context, including the
+/// results that have not been retrieved.
+void solidity_compiler_destroy(solidity_compiler* _compiler) SOLC_NOEXCEPT;
+
+/// Submits a "Standard Input JSON" to be compiled by @p _compiler. The arguments are the same as
+/// for solidity_compile(). The callback is called from the threads of the context and can be
+/// called for different jobs at the same time.
+///
+/// @returns An identifier of the job, which is never zero, or zero if the job could not be submitted.
+size_t solidity_compiler_submit(
+	solidity_compiler* _compiler,
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext
+) SOLC_NOEXCEPT;
+
+/// Retrieves the "Standard Output JSON" of the job @p _job if it has finished.
+///
+/// @returns A pointer to the result, or NULL if the job has not finished yet, is not known or its
+///          result has already been retrieved. NULL is also returned if the result could not be
+///          allocated, in which case it can be retrieved again. The pointer returned must be freed
+///          by the caller using solidity_free() or solidity_reset().
+char* solidity_compiler_poll(solidity_compiler* _compiler, size_t _job) SOLC_NOEXCEPT;
+
+/// Waits for the job @p _job to finish and retrieves its "Standard Output JSON".
+///
+/// @returns A pointer to the result, or NULL if the job is not known or its result has already
+///          been retrieved. NULL is also returned if the result could not be allocated, in which
+///          case it can be retrieved again. The pointer returned must be freed by the caller using
+///          solidity_free() or solidity_reset().
+char* solidity_compiler_wait(solidity_compiler* _compiler, size_t _job) SOLC_NOEXCEPT;
+
 #ifdef __cplusplus
 }
 #endif
@@ -121,7 +121,9 @@ public:
 	///@}
 
 protected:
-	size_t const m_id = 0;
+	/// Only changed by the parser when it moves the nodes of a separately parsed source unit
+	/// into the ID range of the compilation.
+	size_t m_id = 0;
 
 	template <class T>
 	T& initAnnotation() const
@@ -132,6 +134,8 @@ protected:
 	}
 
 private:
+	friend class Parser;
+
 	/// Annotation - is specialised in derived classes, is created upon request (because of polymorphism).
 	mutable std::unique_ptr<ASTAnnotation> m_annotation;
 	SourceLocation m_location;
@@ -195,11 +195,48 @@ Json::Value ASTJsonConverter::toJson(ASTNode const& _node)
 	return util::removeNullMembers(std::move(m_currentValue));
 }
 
+void ASTJsonConverter::write(util::JsonCompactStreamWriter& _writer, ASTNode const& _node)
+{
+	vector<ASTPointer<ASTNode>> subNodes;
+	if (auto const* sourceUnit = dynamic_cast<SourceUnit const*>(&_node))
+		subNodes = sourceUnit->nodes();
+	else if (auto const* contract = dynamic_cast<ContractDefinition const*>(&_node))
+		subNodes = contract->subNodes();
+	else
+	{
+		_writer.value(toJson(_node));
+		return;
+	}
+
+	m_omitSubNodes = true;
+	Json::Value json = toJson(_node);
+	m_omitSubNodes = false;
+
+	_writer.beginObject();
+	for (string const& name: json.getMemberNames())
+	{
+		_writer.key(name);
+		if (name != "nodes")
+			_writer.value(json[name]);
+		else
+		{
+			_writer.beginArray();
+			for (auto const& subNode: subNodes)
+				if (subNode)
+					write(_writer, *subNode);
+				else
+					_writer.value(Json::nullValue);
+			_writer.endArray();
+		}
+	}
+	_writer.endObject();
+}
+
 bool ASTJsonConverter::visit(SourceUnit const& _node)
 {
 	std::vector<pair<string, Json::Value>> attributes = {
 		make_pair("license", _node.licenseString() ? Json::Value(*_node.licenseString()) : Json::nullValue),
-		make_pair("nodes", toJson(_node.nodes()))
+		make_pair("nodes", m_omitSubNodes ? Json::Value(Json::arrayValue) : toJson(_node.nodes()))
 	};
 
 	if (_node.annotation().exportedSymbols.set())
@@ -272,7 +309,7 @@ bool ASTJsonConverter::visit(ContractDefinition const& _node)
 		make_pair("baseContracts", toJson(_node.baseContracts())),
 		make_pair("contractDependencies", getContainerIds(_node.annotation().contractDependencies | ranges::views::keys)),
 		make_pair("usedErrors", getContainerIds(_node.interfaceErrors(false))),
-		make_pair("nodes", toJson(_node.subNodes())),
+		make_pair("nodes", m_omitSubNodes ? Json::Value(Json::arrayValue) : toJson(_node.subNodes())),
 		make_pair("scope", idOrNull(_node.scope()))
 	};
 
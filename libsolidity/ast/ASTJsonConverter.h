@@ -41,6 +41,11 @@ namespace solidity::langutil
 struct SourceLocation;
 }
 
+namespace solidity::util
+{
+class JsonCompactStreamWriter;
+}
+
 namespace solidity::frontend
 {
 
@@ -60,6 +65,10 @@ public:
 	/// Output the json representation of the AST to _stream.
 	void print(std::ostream& _stream, ASTNode const& _node);
 	Json::Value toJson(ASTNode const& _node);
+	/// Writes the json representation of the AST to @a _writer. The result is the same as
+	/// writing toJson(_node), but source units and contracts are written member by member,
+	/// so that only the json of a single member is built at a time.
+	void write(util::JsonCompactStreamWriter& _writer, ASTNode const& _node);
 	template <class T>
 	Json::Value toJson(std::vector<ASTPointer<T>> const& _nodes)
 	{
@@ -195,6 +204,7 @@ private:
 
 	CompilerStack::State m_stackState = CompilerStack::State::Empty; ///< Used to only access information that already exists
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
+	bool m_omitSubNodes = false; ///< whether the "nodes" of source units and contracts are left empty
 	Json::Value m_currentValue;
 	std::map<std::string, unsigned> m_sourceIndices;
 };
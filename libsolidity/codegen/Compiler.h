@@ -50,6 +50,15 @@ public:
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
 		bytes const& _metadata
 	);
+	/// Generates the code of a contract without running the optimiser on it.
+	/// compileContract() is the same as generateContract() followed by optimise().
+	void generateContract(
+		ContractDefinition const& _contract,
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
+		bytes const& _metadata
+	);
+	/// Runs the optimiser on the generated assembly. Does not access the AST.
+	void optimise();
 	/// @returns Entire assembly.
 	evmasm::Assembly const& assembly() const { return m_context.assembly(); }
 	/// @returns Runtime assembly.
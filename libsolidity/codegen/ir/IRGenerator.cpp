@@ -42,6 +42,8 @@
 
 #include <range/v3/view/map.hpp>
 
+#include <boost/algorithm/string/predicate.hpp>
+
 #include <sstream>
 #include <variant>
 
@@ -74,6 +76,14 @@ void verifyCallGraph(
 	);
 }
 
+string const c_experimentalWarning =
+	"/*******************************************************\n"
+	" *                       WARNING                       *\n"
+	" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
+	" *       It can result in LOSS OF FUNDS or worse       *\n"
+	" *                !USE AT YOUR OWN RISK!               *\n"
+	" *******************************************************/\n\n";
+
 set<CallableDeclaration const*, ASTNode::CompareByID> collectReachableCallables(
 	CallGraph const& _graph
 )
@@ -93,9 +103,29 @@ pair<string, string> IRGenerator::run(
 	map<ContractDefinition const*, string_view const> const& _otherYulSources
 )
 {
-	string const ir = yul::reindent(generate(_contract, _otherYulSources));
+	string ir = generateUnoptimized(_contract, _otherYulSources);
+	string optimizedIR = optimize(ir, m_evmVersion, m_optimiserSettings);
+	return {move(ir), move(optimizedIR)};
+}
 
-	yul::AssemblyStack asmStack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
+string IRGenerator::generateUnoptimized(
+	ContractDefinition const& _contract,
+	map<ContractDefinition const*, string_view const> const& _otherYulSources
+)
+{
+	return c_experimentalWarning + yul::reindent(generate(_contract, _otherYulSources));
+}
+
+string IRGenerator::optimize(
+	string const& _unoptimizedIR,
+	langutil::EVMVersion _evmVersion,
+	OptimiserSettings const& _optimiserSettings
+)
+{
+	solAssert(boost::starts_with(_unoptimizedIR, c_experimentalWarning), "");
+	string const ir = _unoptimizedIR.substr(c_experimentalWarning.size());
+
+	yul::AssemblyStack asmStack(_evmVersion, yul::AssemblyStack::Language::StrictAssembly, _optimiserSettings);
 	if (!asmStack.parseAndAnalyze("", ir))
 	{
 		string errorMessage;
@@ -105,15 +135,7 @@ pair<string, string> IRGenerator::run(
 	}
 	asmStack.optimize();
 
-	string warning =
-		"/*******************************************************\n"
-		" *                       WARNING                       *\n"
-		" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
-		" *       It can result in LOSS OF FUNDS or worse       *\n"
-		" *                !USE AT YOUR OWN RISK!               *\n"
-		" *******************************************************/\n\n";
-
-	return {warning + ir, warning + asmStack.print()};
+	return c_experimentalWarning + asmStack.print();
 }
 
 string IRGenerator::generate(
@@ -57,6 +57,21 @@ public:
 		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
 	);
 
+	/// Generates and returns the unoptimized IR code, i.e. the first element returned by run().
+	std::string generateUnoptimized(
+		ContractDefinition const& _contract,
+		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
+	);
+
+	/// Optimizes (or just pretty-prints, depending on the optimizer settings) IR code
+	/// returned by generateUnoptimized(), i.e. returns the second element returned by run().
+	/// Does not access the AST.
+	static std::string optimize(
+		std::string const& _unoptimizedIR,
+		langutil::EVMVersion _evmVersion,
+		OptimiserSettings const& _optimiserSettings
+	);
+
 private:
 	std::string generate(
 		ContractDefinition const& _contract,
@@ -26,22 +26,50 @@
 #include <z3_version.h>
 #endif
 
+#include <mutex>
+#include <thread>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::langutil;
 using namespace solidity::frontend;
 
+namespace
+{
+
+/// @returns a callback that forwards to @a _callback, but never runs more than one call at a time.
+ReadCallback::Callback serializedCallback(ReadCallback::Callback _callback)
+{
+	if (!_callback)
+		return _callback;
+	auto callbackMutex = make_shared<mutex>();
+	return [callbackMutex, callback = move(_callback)](string const& _kind, string const& _data) {
+		lock_guard<mutex> lock(*callbackMutex);
+		return callback(_kind, _data);
+	};
+}
+
+}
+
 BMC::BMC(
 	smt::EncodingContext& _context,
 	ErrorReporter& _errorReporter,
 	map<h256, string> const& _smtlib2Responses,
 	ReadCallback::Callback const& _smtCallback,
 	smtutil::SMTSolverChoice _enabledSolvers,
-	ModelCheckerSettings const& _settings
+	ModelCheckerSettings const& _settings,
+	shared_ptr<smtutil::QueryCache> _queryCache
 ):
 	SMTEncoder(_context, _settings),
-	m_interface(make_unique<smtutil::SMTPortfolio>(_smtlib2Responses, _smtCallback, _enabledSolvers, _settings.timeout)),
+	m_interface(make_unique<smtutil::SMTPortfolio>(
+		_smtlib2Responses,
+		_settings.jobs > 1 ? serializedCallback(_smtCallback) : _smtCallback,
+		_enabledSolvers,
+		_settings.timeout,
+		move(_queryCache)
+	)),
+	m_targetAssertions(*m_interface),
 	m_outerErrorReporter(_errorReporter)
 {
 #if defined (HAVE_Z3) || defined (HAVE_CVC4)
@@ -75,7 +103,7 @@ void BMC::analyze(SourceUnit const& _source, map<ASTNode const*, set<Verificatio
 	// If this check is true, Z3 and CVC4 are not available
 	// and the query answers were not provided, since SMTPortfolio
 	// guarantees that SmtLib2Interface is the first solver.
-	if (!m_interface->unhandledQueries().empty() && m_interface->solvers() == 1)
+	if (!unhandledQueries().empty() && m_interface->solvers() == 1)
 	{
 		if (!m_noSolverWarning)
 		{
@@ -660,8 +688,75 @@ pair<vector<smtutil::Expression>, vector<string>> BMC::modelExpressions()
 
 void BMC::checkVerificationTargets()
 {
+	if (m_settings.jobs > 1)
+		solveVerificationTargetsInParallel();
+
 	for (auto& target: m_verificationTargets)
 		checkVerificationTarget(target);
+	m_targetAssertions.clear();
+
+	if (m_queryMode == QueryMode::Replay)
+	{
+		solAssert(m_nextPrecomputedResult == m_precomputedResults.size(), "");
+		m_precomputedResults.clear();
+		m_nextPrecomputedResult = 0;
+		m_queryMode = QueryMode::Solve;
+	}
+}
+
+void BMC::solveVerificationTargetsInParallel()
+{
+	// Running the checks in collection mode does not report anything,
+	// it only records the queries that the checks would send to the solver.
+	solAssert(m_queryMode == QueryMode::Solve, "");
+	m_queryMode = QueryMode::Collect;
+	for (auto& target: m_verificationTargets)
+		checkVerificationTarget(target);
+	vector<Query> queries = move(m_collectedQueries);
+	m_collectedQueries.clear();
+
+	// Each worker has its own solver and handles a fixed range of consecutive queries,
+	// so that the results do not depend on the scheduling of the threads and
+	// the worker can keep the assertions that consecutive targets share.
+	size_t workers = min<size_t>(m_settings.jobs, queries.size());
+	vector<QueryResult> results(queries.size());
+	auto solveQueries = [&](size_t _worker) {
+		unique_ptr<smtutil::SMTPortfolio> solver = m_interface->cloneDeclarations();
+		IncrementalAssertions assertions(*solver);
+		size_t end = queries.size() * (_worker + 1) / workers;
+		for (size_t i = queries.size() * _worker / workers; i < end; ++i)
+		{
+			QueryResult& result = results[i];
+			size_t unhandledBefore = solver->unhandledQueries().size();
+			assertions.assertOnly(queries[i].assertions);
+			solver->push();
+			solver->addAssertion(queries[i].condition);
+			try
+			{
+				tie(result.result, result.values) = solver->check(queries[i].expressionsToEvaluate);
+			}
+			catch (smtutil::SolverError const& _e)
+			{
+				result.solverError = _e.comment() ? *_e.comment() : "";
+			}
+			solver->pop();
+			vector<string> unhandled = solver->unhandledQueries();
+			result.unhandledQueries.assign(unhandled.begin() + static_cast<ptrdiff_t>(unhandledBefore), unhandled.end());
+		}
+	};
+	vector<thread> threads;
+	for (size_t worker = 1; worker < workers; ++worker)
+		threads.emplace_back(solveQueries, worker);
+	if (workers > 0)
+		solveQueries(0);
+	for (auto& thread: threads)
+		thread.join();
+
+	for (QueryResult const& result: results)
+		m_parallelUnhandledQueries += result.unhandledQueries;
+	m_precomputedResults = move(results);
+	m_nextPrecomputedResult = 0;
+	m_queryMode = QueryMode::Replay;
 }
 
 void BMC::checkVerificationTarget(BMCVerificationTarget& _target)
@@ -699,7 +794,7 @@ void BMC::checkConstantCondition(BMCVerificationTarget& _target)
 {
 	checkBooleanNotConstant(
 		*_target.expression,
-		_target.constraints,
+		_target.constraints && _target.assertions,
 		_target.value,
 		_target.callStack
 	);
@@ -726,6 +821,7 @@ void BMC::checkUnderflow(BMCVerificationTarget& _target)
 		intType = TypeProvider::uint256();
 
 	checkCondition(
+		_target.assertions,
 		_target.constraints && _target.value < smt::minValue(*intType),
 		_target.callStack,
 		_target.modelExpressions,
@@ -759,6 +855,7 @@ void BMC::checkOverflow(BMCVerificationTarget& _target)
 		intType = TypeProvider::uint256();
 
 	checkCondition(
+		_target.assertions,
 		_target.constraints && _target.value > smt::maxValue(*intType),
 		_target.callStack,
 		_target.modelExpressions,
@@ -782,6 +879,7 @@ void BMC::checkDivByZero(BMCVerificationTarget& _target)
 		return;
 
 	checkCondition(
+		_target.assertions,
 		_target.constraints && (_target.value == 0),
 		_target.callStack,
 		_target.modelExpressions,
@@ -798,6 +896,7 @@ void BMC::checkBalance(BMCVerificationTarget& _target)
 {
 	solAssert(_target.type == VerificationTargetType::Balance, "");
 	checkCondition(
+		_target.assertions,
 		_target.constraints && _target.value,
 		_target.callStack,
 		_target.modelExpressions,
@@ -820,6 +919,7 @@ void BMC::checkAssert(BMCVerificationTarget& _target)
 		return;
 
 	checkCondition(
+		_target.assertions,
 		_target.constraints && !_target.value,
 		_target.callStack,
 		_target.modelExpressions,
@@ -843,8 +943,9 @@ void BMC::addVerificationTarget(
 		{
 			_type,
 			_value,
-			currentPathConditions() && m_context.assertions()
+			currentPathConditions()
 		},
+		m_context.assertions(),
 		_expression,
 		m_callStack,
 		modelExpressions()
@@ -858,6 +959,7 @@ void BMC::addVerificationTarget(
 /// Solving.
 
 void BMC::checkCondition(
+	smtutil::Expression const& _assertions,
 	smtutil::Expression _condition,
 	vector<SMTEncoder::CallStackEntry> const& _callStack,
 	pair<vector<smtutil::Expression>, vector<string>> const& _modelExpressions,
@@ -869,9 +971,6 @@ void BMC::checkCondition(
 	smtutil::Expression const* _additionalValue
 )
 {
-	m_interface->push();
-	m_interface->addAssertion(_condition);
-
 	vector<smtutil::Expression> expressionsToEvaluate;
 	vector<string> expressionNames;
 	tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
@@ -881,6 +980,20 @@ void BMC::checkCondition(
 			expressionsToEvaluate.emplace_back(*_additionalValue);
 			expressionNames.push_back(_additionalValueName);
 		}
+
+	if (m_queryMode == QueryMode::Collect)
+	{
+		m_collectedQueries.push_back({_assertions, move(_condition), move(expressionsToEvaluate)});
+		return;
+	}
+
+	if (m_queryMode == QueryMode::Solve)
+	{
+		m_targetAssertions.assertOnly(_assertions);
+		m_interface->push();
+		m_interface->addAssertion(_condition);
+	}
+
 	smtutil::CheckResult result;
 	vector<string> values;
 	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
@@ -941,7 +1054,8 @@ void BMC::checkCondition(
 		break;
 	}
 
-	m_interface->pop();
+	if (m_queryMode == QueryMode::Solve)
+		m_interface->pop();
 }
 
 void BMC::checkBooleanNotConstant(
@@ -1007,17 +1121,33 @@ BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expres
 {
 	smtutil::CheckResult result;
 	vector<string> values;
-	try
+	optional<string> solverError;
+	if (m_queryMode == QueryMode::Replay)
 	{
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
+		solAssert(m_nextPrecomputedResult < m_precomputedResults.size(), "");
+		QueryResult& precomputed = m_precomputedResults[m_nextPrecomputedResult++];
+		result = precomputed.result;
+		values = move(precomputed.values);
+		solverError = move(precomputed.solverError);
 	}
-	catch (smtutil::SolverError const& _e)
+	else
+		try
+		{
+			tie(result, values) = m_interface->check(_expressionsToEvaluate);
+		}
+		catch (smtutil::SolverError const& _e)
+		{
+			solverError = _e.comment() ? *_e.comment() : "";
+		}
+
+	if (solverError)
 	{
 		string description("BMC: Error querying SMT solver");
-		if (_e.comment())
-			description += ": " + *_e.comment();
+		if (!solverError->empty())
+			description += ": " + *solverError;
 		m_errorReporter.warning(8140_error, description);
 		result = smtutil::CheckResult::ERROR;
+		values.clear();
 	}
 
 	for (string& value: values)
@@ -1038,6 +1168,45 @@ smtutil::CheckResult BMC::checkSatisfiable()
 	return checkSatisfiableAndGenerateModel({}).first;
 }
 
+void BMC::IncrementalAssertions::assertOnly(smtutil::Expression const& _assertions)
+{
+	// The links of the chain `c_n && (c_n-1 && (... && c_1))`, from the innermost to the outermost.
+	vector<smtutil::Expression const*> chain;
+	smtutil::Expression const* link = &_assertions;
+	for (; link->name == "and" && link->arguments.size() == 2; link = &link->arguments.at(1))
+		chain.push_back(link);
+	chain.push_back(link);
+	reverse(chain.begin(), chain.end());
+
+	auto identity = [](smtutil::Expression const& _link) {
+		return make_pair(_link.arguments.id(), _link.name);
+	};
+	size_t common = 0;
+	while (
+		common < m_asserted.size() &&
+		common < chain.size() &&
+		m_asserted.at(common) == identity(*chain.at(common))
+	)
+		++common;
+
+	for (; m_asserted.size() > common; m_asserted.pop_back())
+		m_solver.pop();
+	for (; common < chain.size(); ++common)
+	{
+		smtutil::Expression const& conjunct = common == 0 ? *chain.at(common) : chain.at(common)->arguments.at(0);
+		m_solver.push();
+		if (!(conjunct.name == "true" && conjunct.arguments.empty()))
+			m_solver.addAssertion(conjunct);
+		m_asserted.push_back(identity(*chain.at(common)));
+	}
+}
+
+void BMC::IncrementalAssertions::clear()
+{
+	for (; !m_asserted.empty(); m_asserted.pop_back())
+		m_solver.pop();
+}
+
 void BMC::assignment(smt::SymbolicVariable& _symVar, smtutil::Expression const& _value)
 {
 	auto oldVar = _symVar.currentValue();
@@ -35,9 +35,11 @@
 
 #include <libsolidity/interface/ReadFile.h>
 
+#include <libsmtutil/SMTPortfolio.h>
 #include <libsmtutil/SolverInterface.h>
 #include <liblangutil/ErrorReporter.h>
 
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -63,7 +65,8 @@ public:
 		std::map<h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		smtutil::SMTSolverChoice _enabledSolvers,
-		ModelCheckerSettings const& _settings
+		ModelCheckerSettings const& _settings,
+		std::shared_ptr<smtutil::QueryCache> _queryCache = nullptr
 	);
 
 	void analyze(SourceUnit const& _sources, std::map<ASTNode const*, std::set<VerificationTargetType>> _solvedTargets);
@@ -71,7 +74,7 @@ public:
 	/// This is used if the SMT solver is not directly linked into this binary.
 	/// @returns a list of inputs to the SMT solver that were not part of the argument to
 	/// the constructor.
-	std::vector<std::string> unhandledQueries() { return m_interface->unhandledQueries(); }
+	std::vector<std::string> unhandledQueries() { return m_interface->unhandledQueries() + m_parallelUnhandledQueries; }
 
 	/// @returns true if _funCall should be inlined, otherwise false.
 	/// @param _scopeContract The contract that contains the current function being analyzed.
@@ -130,14 +133,21 @@ private:
 
 	/// Verification targets.
 	//@{
+	/// The constraints of a BMC verification target are its path conditions,
+	/// the assertions of the encoding context at the target are kept separately
+	/// so that they can be shared between the queries of several targets.
 	struct BMCVerificationTarget: VerificationTarget
 	{
+		smtutil::Expression assertions;
 		Expression const* expression;
 		std::vector<CallStackEntry> callStack;
 		std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> modelExpressions;
 	};
 
 	void checkVerificationTargets();
+	/// Solves the queries of all verification targets of m_verificationTargets concurrently
+	/// and stores the results in m_precomputedResults.
+	void solveVerificationTargetsInParallel();
 	void checkVerificationTarget(BMCVerificationTarget& _target);
 	void checkConstantCondition(BMCVerificationTarget& _target);
 	void checkUnderflow(BMCVerificationTarget& _target);
@@ -154,8 +164,9 @@ private:
 
 	/// Solver related.
 	//@{
-	/// Check that a condition can be satisfied.
+	/// Check that a condition can be satisfied together with @a _assertions.
 	void checkCondition(
+		smtutil::Expression const& _assertions,
 		smtutil::Expression _condition,
 		std::vector<CallStackEntry> const& _callStack,
 		std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> const& _modelExpressions,
@@ -178,9 +189,66 @@ private:
 	checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _expressionsToEvaluate);
 
 	smtutil::CheckResult checkSatisfiable();
+
+	/// Keeps the assertions of the last checked verification target asserted in a solver.
+	/// The assertions of the encoding context form a chain of conjunctions that share
+	/// their inner part with the ones of earlier targets. Each conjunct of the chain is
+	/// asserted on its own solver level, so that checking the next target only retracts
+	/// and adds the conjuncts in which the targets differ, and the solver keeps what it
+	/// learned from the common ones.
+	class IncrementalAssertions
+	{
+	public:
+		explicit IncrementalAssertions(smtutil::SolverInterface& _solver): m_solver(_solver) {}
+
+		/// Changes the asserted conjuncts to the ones of @a _assertions.
+		void assertOnly(smtutil::Expression const& _assertions);
+		/// Retracts all asserted conjuncts.
+		void clear();
+
+	private:
+		smtutil::SolverInterface& m_solver;
+		/// Identities of the asserted links of the chain, from the innermost to the outermost.
+		std::vector<std::pair<void const*, std::string>> m_asserted;
+	};
+	//@}
+
+	/// Queries to the solver and their results, used to check the verification targets
+	/// concurrently if m_settings.jobs is greater than one.
+	//@{
+	struct Query
+	{
+		smtutil::Expression assertions;
+		smtutil::Expression condition;
+		std::vector<smtutil::Expression> expressionsToEvaluate;
+	};
+	struct QueryResult
+	{
+		smtutil::CheckResult result = smtutil::CheckResult::ERROR;
+		std::vector<std::string> values;
+		/// Set if the solver threw a SolverError.
+		std::optional<std::string> solverError;
+		std::vector<std::string> unhandledQueries;
+	};
+	enum class QueryMode
+	{
+		/// Queries are sent to m_interface.
+		Solve,
+		/// Queries are only collected in m_collectedQueries.
+		Collect,
+		/// Queries are answered from m_precomputedResults in the order they were collected.
+		Replay
+	};
+	QueryMode m_queryMode = QueryMode::Solve;
+	std::vector<Query> m_collectedQueries;
+	std::vector<QueryResult> m_precomputedResults;
+	size_t m_nextPrecomputedResult = 0;
+	std::vector<std::string> m_parallelUnhandledQueries;
 	//@}
 
-	std::unique_ptr<smtutil::SolverInterface> m_interface;
+	std::unique_ptr<smtutil::SMTPortfolio> m_interface;
+	/// Assertions shared by the verification targets of the current function in m_interface.
+	IncrementalAssertions m_targetAssertions;
 
 	/// Flags used for better warning messages.
 	bool m_loopExecutionHappened = false;
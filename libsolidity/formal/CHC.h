@@ -38,6 +38,7 @@
 #include <libsolidity/interface/ReadFile.h>
 
 #include <libsmtutil/CHCSolverInterface.h>
+#include <libsmtutil/QueryCache.h>
 
 #include <boost/algorithm/string/join.hpp>
 
@@ -57,7 +58,8 @@ public:
 		std::map<util::h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		smtutil::SMTSolverChoice _enabledSolvers,
-		ModelCheckerSettings const& _settings
+		ModelCheckerSettings const& _settings,
+		std::shared_ptr<smtutil::QueryCache> _queryCache = nullptr
 	);
 
 	void analyze(SourceUnit const& _sources);
@@ -395,6 +397,9 @@ private:
 
 	/// SMT solvers that are chosen at runtime.
 	smtutil::SMTSolverChoice m_enabledSolvers;
+
+	/// Cache of Horn solver answers, null if caching is disabled.
+	std::shared_ptr<smtutil::QueryCache> m_queryCache;
 };
 
 }
@@ -17,6 +17,8 @@
 // SPDX-License-Identifier: GPL-3.0
 
 #include <libsolidity/formal/ModelChecker.h>
+#include <libsolidity/interface/CompilationCache.h>
+
 #ifdef HAVE_Z3
 #include <libsmtutil/Z3Interface.h>
 #endif
@@ -30,6 +32,23 @@ using namespace solidity::util;
 using namespace solidity::langutil;
 using namespace solidity::frontend;
 
+namespace
+{
+
+shared_ptr<smtutil::QueryCache> makeQueryCache(optional<boost::filesystem::path> const& _directory)
+{
+	if (!_directory)
+		return nullptr;
+
+	auto cache = make_shared<CompilationCache>(*_directory);
+	return make_shared<smtutil::QueryCache>(
+		[cache](h256 const& _key) { return cache->load(_key); },
+		[cache](h256 const& _key, Json::Value const& _value) { cache->store(_key, _value); }
+	);
+}
+
+}
+
 ModelChecker::ModelChecker(
 	ErrorReporter& _errorReporter,
 	map<h256, string> const& _smtlib2Responses,
@@ -40,8 +59,9 @@ ModelChecker::ModelChecker(
 	m_errorReporter(_errorReporter),
 	m_settings(_settings),
 	m_context(),
-	m_bmc(m_context, _errorReporter, _smtlib2Responses, _smtCallback, _enabledSolvers, m_settings),
-	m_chc(m_context, _errorReporter, _smtlib2Responses, _smtCallback, _enabledSolvers, m_settings)
+	m_queryCache(makeQueryCache(m_settings.cacheDirectory)),
+	m_bmc(m_context, _errorReporter, _smtlib2Responses, _smtCallback, _enabledSolvers, m_settings, m_queryCache),
+	m_chc(m_context, _errorReporter, _smtlib2Responses, _smtCallback, _enabledSolvers, m_settings, m_queryCache)
 {
 }
 
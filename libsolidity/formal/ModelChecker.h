@@ -30,6 +30,7 @@
 
 #include <libsolidity/interface/ReadFile.h>
 
+#include <libsmtutil/QueryCache.h>
 #include <libsmtutil/SolverInterface.h>
 #include <liblangutil/ErrorReporter.h>
 
@@ -80,6 +81,9 @@ private:
 	/// Stores the context of the encoding.
 	smt::EncodingContext m_context;
 
+	/// Cache of solver answers shared by both engines, null if caching is disabled.
+	std::shared_ptr<smtutil::QueryCache> m_queryCache;
+
 	/// Bounded Model Checker engine.
 	BMC m_bmc;
 
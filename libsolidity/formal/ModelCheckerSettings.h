@@ -20,6 +20,8 @@
 
 #include <libsmtutil/SolverInterface.h>
 
+#include <boost/filesystem/path.hpp>
+
 #include <optional>
 #include <set>
 
@@ -106,6 +108,10 @@ struct ModelCheckerSettings
 	ModelCheckerEngine engine = ModelCheckerEngine::None();
 	ModelCheckerTargets targets = ModelCheckerTargets::Default();
 	std::optional<unsigned> timeout;
+	/// Number of solver instances that check independent BMC targets concurrently.
+	unsigned jobs = 1;
+	/// Directory in which the answers of the SMT and Horn solvers are cached across runs.
+	std::optional<boost::filesystem::path> cacheDirectory;
 };
 
 }
@@ -0,0 +1,76 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * On-disk cache for per-contract compiler output.
+ */
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsolutil/JSON.h>
+
+#include <fstream>
+#include <random>
+#include <sstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace fs = boost::filesystem;
+
+optional<Json::Value> CompilationCache::load(util::h256 const& _key) const
+{
+	ifstream file(entryPath(_key).string(), ios::binary);
+	if (!file)
+		return nullopt;
+
+	stringstream content;
+	content << file.rdbuf();
+	Json::Value value;
+	if (!file || !util::jsonParseStrict(content.str(), value))
+		return nullopt;
+	return value;
+}
+
+void CompilationCache::store(util::h256 const& _key, Json::Value const& _value) const
+{
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return;
+
+	fs::path const target = entryPath(_key);
+	fs::path const temporary = target.string() + "." + to_string(random_device{}()) + ".tmp";
+	{
+		ofstream file(temporary.string(), ios::binary | ios::trunc);
+		file << util::jsonCompactPrint(_value);
+		if (!file.flush())
+		{
+			fs::remove(temporary, error);
+			return;
+		}
+	}
+	fs::rename(temporary, target, error);
+	if (error)
+		fs::remove(temporary, error);
+}
+
+fs::path CompilationCache::entryPath(util::h256 const& _key) const
+{
+	return m_directory / (_key.hex() + ".json");
+}
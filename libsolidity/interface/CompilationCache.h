@@ -0,0 +1,63 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * On-disk cache for per-contract compiler output.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <json/json.h>
+
+#include <boost/filesystem.hpp>
+
+#include <optional>
+
+namespace solidity::frontend
+{
+
+/**
+ * Stores JSON documents in a directory, one file per key.
+ *
+ * The cache does not know what the keys are derived from, callers have to make sure that
+ * the key covers everything the stored value depends on. Entries are written to a temporary
+ * file first and then renamed, so that concurrent compiler processes sharing a directory
+ * never observe partially written entries. I/O failures are not reported: a cache that
+ * cannot be read or written behaves like an empty one.
+ */
+class CompilationCache
+{
+public:
+	/// Uses @a _directory to store entries. The directory is created on first write.
+	explicit CompilationCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the value stored for @a _key or nullopt if there is none or it is unreadable.
+	std::optional<Json::Value> load(util::h256 const& _key) const;
+	/// Stores @a _value under @a _key, replacing any previous entry.
+	void store(util::h256 const& _key, Json::Value const& _value) const;
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+};
+
+}
@@ -69,17 +69,22 @@
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SemVerHandler.h>
 
+#include <libevmasm/Assembly.h>
 #include <libevmasm/Exceptions.h>
 
 #include <libsolutil/SwarmHash.h>
 #include <libsolutil/IpfsHash.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <json/json.h>
 
+#include <atomic>
+#include <exception>
 #include <utility>
 #include <map>
+#include <thread>
 #include <range/v3/view/concat.hpp>
 
 #include <boost/algorithm/string/replace.hpp>
@@ -92,15 +97,16 @@ using namespace solidity::frontend;
 using solidity::util::errinfo_comment;
 using solidity::util::toHex;
 
-static int g_compilerStackCounts = 0;
+static thread_local int g_compilerStackCounts = 0;
 
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
+	m_yulStringRepository{yul::YulStringRepository::create()},
 	m_readFile{std::move(_readFile)},
 	m_enabledSMTSolvers{smtutil::SMTSolverChoice::All()},
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
+	// Because TypeProvider is a per-thread singleton API, we must ensure that
+	// no more than one entity is actually using it at a time on this thread.
 	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
 	++g_compilerStackCounts;
 }
@@ -291,6 +297,7 @@ void CompilerStack::reset(bool _keepSettings)
 	m_stackState = Empty;
 	m_hasError = false;
 	m_sources.clear();
+	m_importCache.clear();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
 	if (!_keepSettings)
@@ -308,12 +315,15 @@ void CompilerStack::reset(bool _keepSettings)
 		m_metadataLiteralSources = false;
 		m_metadataHash = MetadataHash::IPFS;
 		m_stopAfter = State::CompilationSuccessful;
+		m_parserThreads = 1;
+		m_compilerThreads = 1;
 	}
 	m_globalContext.reset();
 	m_sourceOrder.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
 	TypeProvider::reset();
+	m_yulStringRepository = yul::YulStringRepository::create();
 }
 
 void CompilerStack::setSources(StringMap _sources)
@@ -322,45 +332,95 @@ void CompilerStack::setSources(StringMap _sources)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Cannot change sources once set."));
 	if (m_stackState != Empty)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set sources before parsing."));
-	for (auto source: _sources)
+	for (auto& source: _sources)
 		m_sources[source.first].scanner = make_shared<Scanner>(CharStream(/*content*/std::move(source.second), /*name*/source.first));
 	m_stackState = SourcesSet;
 }
 
+void CompilerStack::replaceSource(string const& _sourceName, string _content)
+{
+	bool const imported = isImportedSource(_sourceName);
+	resetToSources(_sourceName);
+	auto charStream = make_shared<CharStream>(move(_content), _sourceName);
+	if (imported)
+		m_importCache[_sourceName] = move(charStream);
+	else
+		m_sources[_sourceName].scanner = make_shared<Scanner>(move(charStream));
+}
+
+void CompilerStack::invalidateImportedSource(string const& _sourceName)
+{
+	if (!isImportedSource(_sourceName))
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Source \"" + _sourceName + "\" was not loaded through the import callback."));
+	resetToSources(_sourceName);
+}
+
+bool CompilerStack::isImportedSource(string const& _sourceName) const
+{
+	if (m_importCache.count(_sourceName))
+		return true;
+	auto source = m_sources.find(_sourceName);
+	return source != m_sources.end() && source->second.fromCallback;
+}
+
+void CompilerStack::resetToSources(string const& _sourceToDrop)
+{
+	if (m_importedSources)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Cannot replace sources after importing ASTs."));
+
+	// The character streams of the unchanged sources are reused instead of copying their contents.
+	// Sources loaded through the callback, also in earlier compilations, are only loaded again
+	// if they are still imported.
+	map<string, shared_ptr<CharStream>> charStreams;
+	map<string, shared_ptr<CharStream>> importCache = move(m_importCache);
+	importCache.erase(_sourceToDrop);
+	for (auto const& [name, source]: m_sources)
+		if (source.scanner && name != _sourceToDrop)
+			(source.fromCallback ? importCache : charStreams)[name] = source.scanner->charStream();
+	map<h256, string> smtlib2Responses = move(m_smtlib2Responses);
+
+	reset(true);
+	m_smtlib2Responses = move(smtlib2Responses);
+	m_importCache = move(importCache);
+	for (auto const& [name, charStream]: charStreams)
+		m_sources[name].scanner = make_shared<Scanner>(charStream);
+	m_stackState = SourcesSet;
+}
+
 bool CompilerStack::parse()
 {
 	if (m_stackState != SourcesSet)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call parse only after the SourcesSet state."));
 	m_errorReporter.clear();
+	yul::YulStringRepository::Scope yulStringScope{m_yulStringRepository};
 
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning(3805_error, "This is a pre-release compiler version, please do not use it in production.");
 
-	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
-
 	vector<string> sourcesToParse;
 	for (auto const& s: m_sources)
 		sourcesToParse.push_back(s.first);
 
-	for (size_t i = 0; i < sourcesToParse.size(); ++i)
+	if (m_parserThreads > 1)
+		parseConcurrently(move(sourcesToParse));
+	else
 	{
-		string const& path = sourcesToParse[i];
-		Source& source = m_sources[path];
-		source.scanner->reset();
-		source.ast = parser.parse(source.scanner);
-		if (!source.ast)
-			solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
-		else
+		Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
+		for (size_t i = 0; i < sourcesToParse.size(); ++i)
 		{
-			source.ast->annotation().path = path;
-			if (m_stopAfter >= ParsedAndImported)
-				for (auto const& newSource: loadMissingSources(*source.ast, path))
-				{
-					string const& newPath = newSource.first;
-					string const& newContents = newSource.second;
-					m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
-					sourcesToParse.push_back(newPath);
-				}
+			string const& path = sourcesToParse[i];
+			Source& source = m_sources[path];
+			source.scanner->reset();
+			source.ast = parser.parse(source.scanner);
+			if (!source.ast)
+				solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
+			else
+			{
+				source.ast->annotation().path = path;
+				if (m_stopAfter >= ParsedAndImported)
+					for (string const& newPath: loadMissingSources(*source.ast, path))
+						sourcesToParse.push_back(newPath);
+			}
 		}
 	}
 
@@ -376,10 +436,87 @@ bool CompilerStack::parse()
 	return !m_hasError;
 }
 
+void CompilerStack::parseConcurrently(vector<string> _sourcesToParse)
+{
+	struct ParsedSource
+	{
+		Source* source = nullptr;
+		ErrorList errors;
+		ErrorReporter errorReporter{errors};
+		unique_ptr<Parser> parser;
+		exception_ptr exception;
+	};
+
+	// Offset of the node IDs of the next source, i.e. the last ID a single parser would have assigned.
+	int64_t lastNodeID = 0;
+	for (size_t waveStart = 0; waveStart < _sourcesToParse.size();)
+	{
+		size_t const waveEnd = _sourcesToParse.size();
+		vector<ParsedSource> wave(waveEnd - waveStart);
+		for (size_t i = waveStart; i < waveEnd; ++i)
+			wave[i - waveStart].source = &m_sources.at(_sourcesToParse[i]);
+
+		atomic<size_t> nextSource{0};
+		auto worker = [&]() {
+			yul::YulStringRepository::Scope yulStringScope{m_yulStringRepository};
+			for (size_t i = nextSource++; i < wave.size(); i = nextSource++)
+				try
+				{
+					ParsedSource& parsed = wave[i];
+					// The scanner is not shared, each source has its own.
+					parsed.source->scanner->reset();
+					parsed.parser = make_unique<Parser>(parsed.errorReporter, m_evmVersion, m_parserErrorRecovery);
+					parsed.parser->recordNodes();
+					parsed.source->ast = parsed.parser->parse(parsed.source->scanner);
+				}
+				catch (...)
+				{
+					wave[i].exception = current_exception();
+				}
+		};
+		vector<thread> threads;
+		for (size_t i = 1; i < min<size_t>(m_parserThreads, wave.size()); ++i)
+			threads.emplace_back(worker);
+		worker();
+		for (thread& t: threads)
+			t.join();
+
+		for (size_t i = waveStart; i < waveEnd; ++i)
+		{
+			string const& path = _sourcesToParse[i];
+			ParsedSource& parsed = wave[i - waveStart];
+			Source& source = *parsed.source;
+			if (parsed.exception || !parsed.errors.empty())
+			{
+				// Diagnostics and their limits depend on what was reported before,
+				// so the source is parsed again at its place in the order.
+				parsed.parser = make_unique<Parser>(m_errorReporter, m_evmVersion, m_parserErrorRecovery);
+				parsed.parser->recordNodes();
+				source.scanner->reset();
+				source.ast = parsed.parser->parse(source.scanner);
+			}
+			parsed.parser->shiftNodeIDs(lastNodeID);
+			lastNodeID += parsed.parser->lastNodeID();
+
+			if (!source.ast)
+				solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
+			else
+			{
+				source.ast->annotation().path = path;
+				if (m_stopAfter >= ParsedAndImported)
+					for (string const& newPath: loadMissingSources(*source.ast, path))
+						_sourcesToParse.push_back(newPath);
+			}
+		}
+		waveStart = waveEnd;
+	}
+}
+
 void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
 {
 	if (m_stackState != Empty)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call importASTs only before the SourcesSet state."));
+	yul::YulStringRepository::Scope yulStringScope{m_yulStringRepository};
 	m_sourceJsons = _sources;
 	map<string, ASTPointer<SourceUnit>> reconstructedSources = ASTJsonImporter(m_evmVersion).jsonToSourceUnit(m_sourceJsons);
 	for (auto& src: reconstructedSources)
@@ -402,6 +539,7 @@ bool CompilerStack::analyze()
 {
 	if (m_stackState != ParsedAndImported || m_stackState >= AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call analyze only after parsing was performed."));
+	yul::YulStringRepository::Scope yulStringScope{m_yulStringRepository};
 	resolveImports();
 
 	for (Source const* source: m_sourceOrder)
@@ -630,7 +768,17 @@ bool CompilerStack::compile(State _stopAfter)
 	if (m_hasError)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called compile with errors."));
 
+	yul::YulStringRepository::Scope yulStringScope{m_yulStringRepository};
+
+	if (m_compilerThreads > 1 && compileConcurrently())
+	{
+		m_stackState = CompilationSuccessful;
+		this->link();
+		return true;
+	}
+
 	// Only compile contracts individually which have been requested.
+	// If compiling them concurrently failed, they are compiled again here to report the failure.
 	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
 
 	for (Source const* source: m_sourceOrder)
@@ -640,17 +788,7 @@ bool CompilerStack::compile(State _stopAfter)
 				{
 					try
 					{
-						if (m_viaIR || m_generateIR || m_generateEwasm)
-							generateIR(*contract);
-						if (m_generateEvmBytecode)
-						{
-							if (m_viaIR)
-								generateEVMFromIR(*contract);
-							else
-								compileContract(*contract, otherCompilers);
-						}
-						if (m_generateEwasm)
-							generateEwasm(*contract);
+						compileRequestedContract(*contract, otherCompilers);
 					}
 					catch (Error const& _error)
 					{
@@ -760,6 +898,7 @@ Json::Value CompilerStack::generatedSources(string const& _contractName, bool _r
 				c.compiler->generatedYulUtilityCode();
 			if (!source.empty())
 			{
+				yul::YulStringRepository::Scope yulStringScope{m_yulStringRepository};
 				string sourceName = CompilerContext::yulUtilityFileName();
 				unsigned sourceIndex = sourceIndices()[sourceName];
 				ErrorList errors;
@@ -1117,10 +1256,10 @@ string const& CompilerStack::Source::ipfsUrl() const
 	return ipfsUrlCached;
 }
 
-StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string const& _sourcePath)
+vector<string> CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string const& _sourcePath)
 {
 	solAssert(m_stackState < ParsedAndImported, "");
-	StringMap newSources;
+	vector<string> newSources;
 	try
 	{
 		for (auto const& node: _ast.nodes())
@@ -1134,15 +1273,30 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string
 				// as seen globally.
 				importPath = applyRemapping(importPath, _sourcePath);
 				import->annotation().absolutePath = importPath;
-				if (m_sources.count(importPath) || newSources.count(importPath))
+				if (m_sources.count(importPath))
+					continue;
+
+				auto cached = m_importCache.find(importPath);
+				if (cached != m_importCache.end())
+				{
+					Source& source = m_sources[importPath];
+					source.scanner = make_shared<Scanner>(cached->second);
+					source.fromCallback = true;
+					newSources.push_back(importPath);
 					continue;
+				}
 
 				ReadCallback::Result result{false, string("File not supplied initially.")};
 				if (m_readFile)
 					result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importPath);
 
 				if (result.success)
-					newSources[importPath] = result.responseOrErrorMessage;
+				{
+					Source& source = m_sources[importPath];
+					source.scanner = make_shared<Scanner>(CharStream(move(result.responseOrErrorMessage), importPath));
+					source.fromCallback = true;
+					newSources.push_back(importPath);
+				}
 				else
 				{
 					m_errorReporter.parserError(
@@ -1226,43 +1380,129 @@ bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& featu
 			return false;
 	return true;
 }
+
+/// Adds @a _assembly and its nested sub-assemblies to @a _assemblies.
+void collectAssemblies(evmasm::Assembly const& _assembly, set<void const*>& _assemblies)
+{
+	if (_assemblies.insert(&_assembly).second)
+		for (size_t subId = 0; subId < _assembly.numSubs(); ++subId)
+			collectAssemblies(_assembly.sub(subId), _assemblies);
+}
 }
 
-void CompilerStack::assemble(
+void CompilerStack::compileRequestedContract(
 	ContractDefinition const& _contract,
-	std::shared_ptr<evmasm::Assembly> _assembly,
-	std::shared_ptr<evmasm::Assembly> _runtimeAssembly
+	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
 )
 {
-	solAssert(m_stackState >= AnalysisPerformed, "");
-	solAssert(!m_hasError, "");
+	if (m_viaIR || m_generateIR || m_generateEwasm)
+		generateIR(_contract);
+	if (m_generateEvmBytecode)
+	{
+		if (m_viaIR)
+			generateEVMFromIR(_contract);
+		else
+			compileContract(_contract, _otherCompilers);
+	}
+	if (m_generateEwasm)
+		generateEwasm(_contract);
+}
 
-	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+bool CompilerStack::compileConcurrently()
+{
+	solAssert(!m_deferredCompilation, "");
+	m_deferredCompilation = make_unique<DeferredCompilation>();
 
-	compiledContract.evmAssembly = _assembly;
-	solAssert(compiledContract.evmAssembly, "");
 	try
 	{
-		// Assemble deployment (incl. runtime)  object.
-		compiledContract.object = compiledContract.evmAssembly->assemble();
+		map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+		for (Source const* source: m_sourceOrder)
+			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+				if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+					if (isRequestedContract(*contract))
+						compileRequestedContract(*contract, otherCompilers);
+
+		// Work only depends on earlier work, so it is run in waves of work whose
+		// dependencies are all in earlier waves.
+		vector<DeferredCompilation::Work> const& work = m_deferredCompilation->work;
+		vector<size_t> waveOfWork(work.size(), 0);
+		vector<vector<size_t>> waves;
+		size_t largestWave = 0;
+		for (size_t i = 0; i < work.size(); ++i)
+		{
+			for (size_t dependency: work[i].dependencies)
+				waveOfWork[i] = max(waveOfWork[i], waveOfWork[dependency] + 1);
+			if (waves.size() <= waveOfWork[i])
+				waves.resize(waveOfWork[i] + 1);
+			waves[waveOfWork[i]].push_back(i);
+			largestWave = max(largestWave, waves[waveOfWork[i]].size());
+		}
+
+		util::ThreadPool threadPool{min<size_t>(m_compilerThreads, largestWave)};
+		for (vector<size_t> const& wave: waves)
+			threadPool.run(wave.size(), [&](size_t _index) {
+				yul::YulStringRepository::Scope yulStringScope{m_yulStringRepository};
+				work[wave[_index]].run();
+			});
 	}
-	catch (evmasm::AssemblyException const&)
+	catch (...)
 	{
-		solAssert(false, "Assembly exception for bytecode");
+		m_deferredCompilation.reset();
+		for (auto& [name, compiledContract]: m_contracts)
+		{
+			compiledContract.compiler.reset();
+			compiledContract.evmAssembly.reset();
+			compiledContract.evmRuntimeAssembly.reset();
+			compiledContract.object = {};
+			compiledContract.runtimeObject = {};
+			compiledContract.yulIR.clear();
+			compiledContract.yulIROptimized.clear();
+			compiledContract.ewasm.clear();
+			compiledContract.ewasmObject = {};
+		}
+		return false;
 	}
-	solAssert(compiledContract.object.immutableReferences.empty(), "Leftover immutables.");
 
-	compiledContract.evmRuntimeAssembly = _runtimeAssembly;
-	solAssert(compiledContract.evmRuntimeAssembly, "");
-	try
+	vector<function<void()>> reports = move(m_deferredCompilation->reports);
+	m_deferredCompilation.reset();
+	for (auto const& report: reports)
+		report();
+	return true;
+}
+
+void CompilerStack::runAfterCodeGeneration(set<void const*> const& _usedObjects, function<void()> _work)
+{
+	if (!m_deferredCompilation)
 	{
-		// Assemble runtime object.
-		compiledContract.runtimeObject = compiledContract.evmRuntimeAssembly->assemble();
+		_work();
+		return;
 	}
-	catch (evmasm::AssemblyException const&)
+
+	size_t const index = m_deferredCompilation->work.size();
+	set<size_t> dependencies;
+	for (void const* object: _usedObjects)
 	{
-		solAssert(false, "Assembly exception for deployed bytecode");
+		auto [lastWork, inserted] = m_deferredCompilation->lastWorkUsing.emplace(object, index);
+		if (!inserted)
+		{
+			dependencies.insert(lastWork->second);
+			lastWork->second = index;
+		}
 	}
+	m_deferredCompilation->work.push_back({move(_work), move(dependencies)});
+}
+
+void CompilerStack::reportAfterCodeGeneration(function<void()> _report)
+{
+	if (m_deferredCompilation)
+		m_deferredCompilation->reports.push_back(move(_report));
+	else
+		_report();
+}
+
+void CompilerStack::checkContractCodeSize(ContractDefinition const& _contract)
+{
+	Contract const& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
 	// Throw a warning if EIP-170 limits are exceeded:
 	//   If contract creation returns data with length greater than 0x6000 (214 + 213) bytes,
@@ -1281,6 +1521,41 @@ void CompilerStack::assemble(
 		);
 }
 
+void CompilerStack::assemble(
+	Contract& _compiledContract,
+	std::shared_ptr<evmasm::Assembly> _assembly,
+	std::shared_ptr<evmasm::Assembly> _runtimeAssembly
+)
+{
+	solAssert(m_stackState >= AnalysisPerformed, "");
+	solAssert(!m_hasError, "");
+
+	_compiledContract.evmAssembly = _assembly;
+	solAssert(_compiledContract.evmAssembly, "");
+	try
+	{
+		// Assemble deployment (incl. runtime)  object.
+		_compiledContract.object = _compiledContract.evmAssembly->assemble();
+	}
+	catch (evmasm::AssemblyException const&)
+	{
+		solAssert(false, "Assembly exception for bytecode");
+	}
+	solAssert(_compiledContract.object.immutableReferences.empty(), "Leftover immutables.");
+
+	_compiledContract.evmRuntimeAssembly = _runtimeAssembly;
+	solAssert(_compiledContract.evmRuntimeAssembly, "");
+	try
+	{
+		// Assemble runtime object.
+		_compiledContract.runtimeObject = _compiledContract.evmRuntimeAssembly->assemble();
+	}
+	catch (evmasm::AssemblyException const&)
+	{
+		solAssert(false, "Assembly exception for deployed bytecode");
+	}
+}
+
 void CompilerStack::compileContract(
 	ContractDefinition const& _contract,
 	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
@@ -1306,19 +1581,28 @@ void CompilerStack::compileContract(
 
 	bytes cborEncodedMetadata = createCBORMetadata(compiledContract);
 
-	try
-	{
-		// Run optimiser and compile the contract.
-		compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
-	}
-	catch(evmasm::OptimizerException const&)
-	{
-		solAssert(false, "Optimizer exception during compilation");
-	}
+	compiler->generateContract(_contract, _otherCompilers, cborEncodedMetadata);
 
 	_otherCompilers[compiledContract.contract] = compiler;
 
-	assemble(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr());
+	// The optimiser also modifies the assemblies of the dependencies, which are shared
+	// with the compilers of the dependencies.
+	set<void const*> usedObjects{&compiledContract};
+	collectAssemblies(compiler->assembly(), usedObjects);
+	runAfterCodeGeneration(usedObjects, [this, compiler, &compiledContract]() {
+		try
+		{
+			// Run optimiser.
+			compiler->optimise();
+		}
+		catch(evmasm::OptimizerException const&)
+		{
+			solAssert(false, "Optimizer exception during compilation");
+		}
+
+		assemble(compiledContract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr());
+	});
+	reportAfterCodeGeneration([this, &_contract]() { checkContractCodeSize(_contract); });
 }
 
 void CompilerStack::generateIR(ContractDefinition const& _contract)
@@ -1332,12 +1616,14 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 		return;
 
 	if (!*_contract.sourceUnit().annotation().useABICoderV2)
-		m_errorReporter.warning(
-			2066_error,
-			_contract.location(),
-			"Contract requests the ABI coder v1, which is incompatible with the IR. "
-			"Using ABI coder v2 instead."
-		);
+		reportAfterCodeGeneration([this, &_contract]() {
+			m_errorReporter.warning(
+				2066_error,
+				_contract.location(),
+				"Contract requests the ABI coder v1, which is incompatible with the IR. "
+				"Using ABI coder v2 instead."
+			);
+		});
 
 	string dependenciesSource;
 	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
@@ -1351,7 +1637,10 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 		otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
 
 	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings);
-	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(_contract, otherYulSources);
+	compiledContract.yulIR = generator.generateUnoptimized(_contract, otherYulSources);
+	runAfterCodeGeneration({&compiledContract}, [this, &compiledContract]() {
+		compiledContract.yulIROptimized = IRGenerator::optimize(compiledContract.yulIR, m_evmVersion, m_optimiserSettings);
+	});
 }
 
 void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
@@ -1364,23 +1653,29 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
+	solAssert(!compiledContract.yulIR.empty(), "");
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
-	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
-	stack.optimize();
+	string deployedName = IRNames::deployedObject(_contract);
+	solAssert(!deployedName.empty(), "");
 
-	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
+	runAfterCodeGeneration({&compiledContract}, [this, &compiledContract, deployedName]() {
+		solAssert(!compiledContract.yulIROptimized.empty(), "");
 
-	// TODO: support passing metadata
+		// Re-parse the Yul IR in EVM dialect
+		yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
+		stack.parseAndAnalyze("", compiledContract.yulIROptimized);
+		stack.optimize();
 
-	string deployedName = IRNames::deployedObject(_contract);
-	solAssert(!deployedName.empty(), "");
-	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack.assembleEVMWithDeployed(deployedName);
-	assemble(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
+		//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
+
+		// TODO: support passing metadata
+
+		tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack.assembleEVMWithDeployed(deployedName);
+		assemble(compiledContract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
+	});
+	reportAfterCodeGeneration([this, &_contract]() { checkContractCodeSize(_contract); });
 }
 
 void CompilerStack::generateEwasm(ContractDefinition const& _contract)
@@ -1393,24 +1688,28 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
+	solAssert(!compiledContract.yulIR.empty(), "");
 	if (!compiledContract.ewasm.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
-	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
+	runAfterCodeGeneration({&compiledContract}, [this, &compiledContract]() {
+		solAssert(!compiledContract.yulIROptimized.empty(), "");
 
-	stack.optimize();
-	stack.translate(yul::AssemblyStack::Language::Ewasm);
-	stack.optimize();
+		// Re-parse the Yul IR in EVM dialect
+		yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
+		stack.parseAndAnalyze("", compiledContract.yulIROptimized);
 
-	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
+		stack.optimize();
+		stack.translate(yul::AssemblyStack::Language::Ewasm);
+		stack.optimize();
 
-	// Turn into Ewasm text representation.
-	auto result = stack.assemble(yul::AssemblyStack::Machine::Ewasm);
-	compiledContract.ewasm = std::move(result.assembly);
-	compiledContract.ewasmObject = std::move(*result.bytecode);
+		//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
+
+		// Turn into Ewasm text representation.
+		auto result = stack.assemble(yul::AssemblyStack::Machine::Ewasm);
+		compiledContract.ewasm = std::move(result.assembly);
+		compiledContract.ewasmObject = std::move(*result.bytecode);
+	});
 }
 
 CompilerStack::Contract const& CompilerStack::contract(string const& _contractName) const
@@ -47,6 +47,7 @@
 
 #include <json/json.h>
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <ostream>
@@ -60,6 +61,11 @@ class Scanner;
 }
 
 
+namespace solidity::yul
+{
+class YulStringRepository;
+}
+
 namespace solidity::evmasm
 {
 class Assembly;
@@ -86,6 +92,8 @@ class DeclarationContainer;
  * before compilation to bytecode) or run the whole compilation in one call.
  * If error recovery is active, it is possible to progress through the stages even when
  * there are errors. In any case, producing code is only possible without errors.
+ * Only one CompilerStack can exist per thread at a time and it has to be used on the thread
+ * that created it, since the types it produces are owned by that thread's TypeProvider.
  */
 class CompilerStack
 {
@@ -163,6 +171,17 @@ public:
 		m_parserErrorRecovery = _wantErrorRecovery;
 	}
 
+	/// Sets the number of threads used to parse source units concurrently.
+	/// Does not influence the result, including the AST node IDs.
+	/// Must be set before parsing.
+	void setParserThreads(unsigned _threads) { m_parserThreads = std::max(_threads, 1u); }
+
+	/// Sets the number of threads used to optimise and assemble the contracts concurrently.
+	/// The code is still generated from the AST on the calling thread.
+	/// Does not influence the result.
+	/// Must be set before compiling.
+	void setCompilerThreads(unsigned _threads) { m_compilerThreads = std::max(_threads, 1u); }
+
 	/// Sets the pipeline to go through the Yul IR or not.
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
@@ -207,6 +226,23 @@ public:
 	/// Sets the sources. Must be set before parsing.
 	void setSources(StringMap _sources);
 
+	/// Replaces the content of the source unit @a _sourceName (or adds it) and returns the stack to
+	/// the SourcesSet state, keeping the settings, the SMTLib2 responses and the contents of all
+	/// other source units.
+	/// Intended for long-running clients that recompile after editing a single file: source units
+	/// loaded through the callback are only part of the next compilation if they are still imported,
+	/// and are then not requested from the callback again. Replacing such a source unit keeps it
+	/// that way and only changes the content used when it is imported. All source units are parsed
+	/// and analysed anew, since the annotations of the previous run refer to types that are
+	/// discarded here.
+	/// Can be called in any state, except after importASTs.
+	void replaceSource(std::string const& _sourceName, std::string _content);
+	/// Discards the content of the source unit @a _sourceName that was loaded through the import
+	/// callback, so that it is requested from the callback again when it is imported the next time,
+	/// and returns the stack to the SourcesSet state like replaceSource().
+	/// Has to be called if the file changed, since the content is kept across compilations otherwise.
+	void invalidateImportedSource(std::string const& _sourceName);
+
 	/// Adds a response to an SMTLib2 query (identified by the hash of the query input).
 	/// Must be set before parsing.
 	void addSMTLib2Response(util::h256 const& _hash, std::string const& _response);
@@ -351,6 +387,8 @@ private:
 	{
 		std::shared_ptr<langutil::Scanner> scanner;
 		std::shared_ptr<SourceUnit> ast;
+		/// True if the source unit was loaded through the import callback.
+		bool fromCallback = false;
 		util::h256 mutable keccak256HashCached;
 		util::h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
@@ -361,6 +399,22 @@ private:
 	};
 
 	/// The state per contract. Filled gradually during compilation.
+	/// Work collected while generating the code of all contracts concurrently.
+	struct DeferredCompilation
+	{
+		struct Work
+		{
+			std::function<void()> run;
+			/// Indices of the work that has to be done before.
+			std::set<size_t> dependencies;
+		};
+		std::vector<Work> work;
+		/// Index of the last work that uses an object, e.g. an assembly or the output of a contract.
+		std::map<void const*, size_t> lastWorkUsing;
+		/// Reports warnings, in the order of the serial compilation.
+		std::vector<std::function<void()>> reports;
+	};
+
 	struct Contract
 	{
 		ContractDefinition const* contract = nullptr;
@@ -387,10 +441,23 @@ private:
 	void createAndAssignCallGraphs();
 	void findAndReportCyclicContractDependencies();
 
-	/// Loads the missing sources from @a _ast (named @a _path) using the callback
-	/// @a m_readFile and stores the absolute paths of all imports in the AST annotations.
-	/// @returns the newly loaded sources.
-	StringMap loadMissingSources(SourceUnit const& _ast, std::string const& _path);
+	/// @returns true if the source unit @a _sourceName was loaded through the import callback.
+	bool isImportedSource(std::string const& _sourceName) const;
+	/// Returns the stack to the SourcesSet state, keeping the settings, the SMTLib2 responses and
+	/// the contents of all source units except @a _sourceToDrop.
+	void resetToSources(std::string const& _sourceToDrop);
+
+	/// Loads the missing sources from @a _ast (named @a _path) from m_importCache or using the
+	/// callback @a m_readFile, adds them to m_sources and stores the absolute paths of all imports
+	/// in the AST annotations.
+	/// @returns the paths of the newly loaded sources.
+	std::vector<std::string> loadMissingSources(SourceUnit const& _ast, std::string const& _path);
+	/// Parses @a _sourcesToParse and the sources they import using m_parserThreads threads.
+	/// The sources are parsed concurrently in waves and their imports are loaded in the
+	/// order in which a single parser would load them. The node IDs are moved afterwards
+	/// to the ones a single parser would assign. Sources for which the parser reports
+	/// anything are parsed again in that order using m_errorReporter.
+	void parseConcurrently(std::vector<std::string> _sourcesToParse);
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
 
@@ -403,14 +470,41 @@ private:
 	/// @returns true if the contract is requested to be compiled.
 	bool isRequestedContract(ContractDefinition const& _contract) const;
 
-	/// Assembles the contract.
+	/// Assembles the contract. Does not access the AST.
 	/// This function should only be internally called by compileContract and generateEVMFromIR.
 	void assemble(
-		ContractDefinition const& _contract,
+		Contract& _compiledContract,
 		std::shared_ptr<evmasm::Assembly> _assembly,
 		std::shared_ptr<evmasm::Assembly> _runtimeAssembly
 	);
 
+	/// Generates the requested outputs for @a _contract and its dependencies.
+	/// This function should only be internally called by compile and compileConcurrently.
+	void compileRequestedContract(
+		ContractDefinition const& _contract,
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
+	);
+
+	/// Compiles the requested contracts like compile(), but only generates their code from the
+	/// AST on the calling thread. The work that does not access the AST, i.e. optimising and
+	/// assembling, is collected and run afterwards using m_compilerThreads threads, keeping the
+	/// order of the serial compilation between work that uses the same objects.
+	/// Warnings are reported afterwards in the order of the serial compilation.
+	/// @returns false if anything failed. Nothing is reported in that case and the outputs of all
+	/// contracts are cleared, so that they can be compiled serially using m_errorReporter.
+	bool compileConcurrently();
+
+	/// Runs @a _work now or, during compileConcurrently(), after all code is generated, once the
+	/// work deferred before that uses any of @a _usedObjects is done. @a _work must not access
+	/// the AST or report anything.
+	void runAfterCodeGeneration(std::set<void const*> const& _usedObjects, std::function<void()> _work);
+
+	/// Calls @a _report now or, during compileConcurrently(), after all deferred work is done.
+	void reportAfterCodeGeneration(std::function<void()> _report);
+
+	/// Warns if the runtime code of @a _contract is too large to be deployed.
+	void checkContractCodeSize(ContractDefinition const& _contract);
+
 	/// Compile a single contract.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
@@ -476,6 +570,9 @@ private:
 		FunctionDefinition const& _function
 	) const;
 
+	/// Owns the YulStrings of the sources and of the generated code. It is bound to the thread
+	/// in all functions that create YulStrings and declared first, so that it outlives their users.
+	std::shared_ptr<yul::YulStringRepository> m_yulStringRepository;
 	ReadCallback::Callback m_readFile;
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
@@ -491,6 +588,10 @@ private:
 	std::map<std::string, util::h160> m_libraries;
 	ImportRemapper m_importRemapper;
 	std::map<std::string const, Source> m_sources;
+	/// Contents of the source units loaded through the import callback before the last call to
+	/// replaceSource, also in earlier compilations, unless they were invalidated. Used instead of
+	/// the callback when they are imported again.
+	std::map<std::string, std::shared_ptr<langutil::CharStream>> m_importCache;
 	// if imported, store AST-JSONS for each filename
 	std::map<std::string, Json::Value> m_sourceJsons;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
@@ -504,6 +605,11 @@ private:
 	bool m_metadataLiteralSources = false;
 	MetadataHash m_metadataHash = MetadataHash::IPFS;
 	bool m_parserErrorRecovery = false;
+	unsigned m_parserThreads = 1;
+	unsigned m_compilerThreads = 1;
+	/// Work deferred by runAfterCodeGeneration() and reportAfterCodeGeneration(), only set during
+	/// compileConcurrently().
+	std::unique_ptr<DeferredCompilation> m_deferredCompilation;
 	State m_stackState = Empty;
 	bool m_importedSources = false;
 	/// Whether or not there has been an error during processing.
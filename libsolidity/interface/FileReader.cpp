@@ -80,7 +80,7 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 		// NOTE: we ignore the FileNotFound exception as we manually check above
 		auto contents = readFileAsString(canonicalPath.string());
 		m_sourceCodes[_sourceUnitName] = contents;
-		return ReadCallback::Result{true, contents};
+		return ReadCallback::Result{true, std::move(contents)};
 	}
 	catch (util::Exception const& _exception)
 	{
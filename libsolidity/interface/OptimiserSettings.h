@@ -150,6 +150,12 @@ struct OptimiserSettings
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Number of threads the Yul optimiser may use to optimise independent functions in parallel.
+	/// Does not influence the output and is thus not part of the comparison above.
+	size_t yulOptimiserThreads = 1;
+	/// Number of threads the opcode-based optimiser may use to optimise independent sub-assemblies in parallel.
+	/// Does not influence the output and is thus not part of the comparison above.
+	size_t opcodeOptimiserThreads = 1;
 };
 
 }
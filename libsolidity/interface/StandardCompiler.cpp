@@ -39,6 +39,7 @@
 
 #include <algorithm>
 #include <optional>
+#include <sstream>
 
 using namespace std;
 using namespace solidity;
@@ -157,6 +158,45 @@ map<string, set<string>> requestedContractNames(Json::Value const& _outputSelect
 	return contracts;
 }
 
+/// @returns true iff @a _requestedContracts (as returned by requestedContractNames) selects the
+/// contract @a _name from the source unit @a _sourceName. Mirrors CompilerStack::isRequestedContract.
+bool isRequestedContract(
+	map<string, set<string>> const& _requestedContracts,
+	string const& _sourceName,
+	string const& _name
+)
+{
+	if (_requestedContracts.empty())
+		return true;
+
+	for (string const& key: {string(), _sourceName})
+		if (auto it = _requestedContracts.find(key); it != _requestedContracts.end())
+			if (it->second.count(_name) || it->second.count(""))
+				return true;
+
+	return false;
+}
+
+/// @returns the key under which the output of @a _contractName is stored in the compilation cache.
+/// The metadata covers the compiler version, all settings that influence code generation and the
+/// hashes of all sources the contract depends on. The list of source units is included because
+/// source indices appear in source mappings and generated sources.
+util::h256 contractCacheKey(
+	CompilerStack const& _compilerStack,
+	string const& _contractName,
+	Json::Value const& _outputSelection
+)
+{
+	Json::Value key(Json::objectValue);
+	key["contract"] = _contractName;
+	key["metadata"] = _compilerStack.metadata(_contractName);
+	key["sources"] = Json::arrayValue;
+	for (string const& sourceName: _compilerStack.sourceNames())
+		key["sources"].append(sourceName);
+	key["outputSelection"] = _outputSelection;
+	return util::keccak256(util::jsonCompactPrint(key));
+}
+
 /// Returns true iff @a _hash (hex with 0x prefix) is the Keccak256 hash of the binary data in @a _content.
 bool hashMatchesContent(string const& _hash, string const& _content)
 {
@@ -288,6 +328,19 @@ bool isEvmBytecodeRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns true if the EVM assembly of any contract was requested, which quotes the sources.
+bool isEvmAssemblyRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			if (isArtifactRequested(requests, "evm.assembly", false))
+				return true;
+	return false;
+}
+
 /// @returns true if any Ewasm code was requested. Note that as an exception, '*' does not
 /// yet match "ewasm.wast" or "ewasm"
 bool isEwasmRequested(Json::Value const& _outputSelection)
@@ -431,13 +484,13 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "parallelism", "remappings", "stopAfter", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
 std::optional<Json::Value> checkModelCheckerSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"contracts", "engine", "targets", "timeout"};
+	static set<string> keys{"contracts", "engine", "jobs", "targets", "timeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
@@ -604,12 +657,19 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 			if (!settings.runYulOptimiser)
 				return formatFatalError("JSONError", "\"Providing yulDetails requires Yul optimizer to be enabled.");
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
+			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps", "threads"}, "settings.optimizer.details.yulDetails"))
 				return *result;
 			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
 			if (auto error = checkOptimizerDetailSteps(details["yulDetails"], "optimizerSteps", settings.yulOptimiserSteps))
 				return *error;
+			if (details["yulDetails"].isMember("threads"))
+			{
+				Json::Value const& threads = details["yulDetails"]["threads"];
+				if (!threads.isUInt() || threads.asUInt() == 0)
+					return formatFatalError("JSONError", "settings.optimizer.details.yulDetails.threads must be a positive integer.");
+				settings.yulOptimiserThreads = threads.asUInt();
+			}
 		}
 	}
 	return { std::move(settings) };
@@ -661,7 +721,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 					"Mismatch between content and supplied hash for \"" + sourceName + "\""
 				));
 			else
-				ret.sources[sourceName] = content;
+				ret.sources[sourceName] = move(content);
 		}
 		else if (sources[sourceName]["urls"].isArray())
 		{
@@ -687,7 +747,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 						));
 					else
 					{
-						ret.sources[sourceName] = result.responseOrErrorMessage;
+						ret.sources[sourceName] = move(result.responseOrErrorMessage);
 						found = true;
 						break;
 					}
@@ -777,6 +837,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.viaIR = settings["viaIR"].asBool();
 	}
 
+	if (settings.isMember("parallelism"))
+	{
+		if (!settings["parallelism"].isUInt() || settings["parallelism"].asUInt() == 0)
+			return formatFatalError("JSONError", "\"settings.parallelism\" must be a positive integer.");
+		ret.parallelism = settings["parallelism"].asUInt();
+	}
+
 	if (settings.isMember("evmVersion"))
 	{
 		if (!settings["evmVersion"].isString())
@@ -974,15 +1041,28 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.timeout = modelCheckerSettings["timeout"].asUInt();
 	}
 
+	if (modelCheckerSettings.isMember("jobs"))
+	{
+		if (!modelCheckerSettings["jobs"].isUInt() || modelCheckerSettings["jobs"].asUInt() == 0)
+			return formatFatalError("JSONError", "settings.modelChecker.jobs must be a positive integer.");
+		ret.modelCheckerSettings.jobs = modelCheckerSettings["jobs"].asUInt();
+	}
+
 	return { std::move(ret) };
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+Json::Value StandardCompiler::compileSolidity(
+	StandardCompiler::InputsAndSettings _inputsAndSettings,
+	util::JsonCompactStreamWriter* _writer
+)
 {
 	CompilerStack compilerStack(m_readFile);
 
-	StringMap sourceList = std::move(_inputsAndSettings.sources);
-	compilerStack.setSources(sourceList);
+	// The sources are only copied if the assembly, which quotes them, is requested.
+	StringMap sourceList;
+	if (isEvmAssemblyRequested(_inputsAndSettings.outputSelection))
+		sourceList = _inputsAndSettings.sources;
+	compilerStack.setSources(std::move(_inputsAndSettings.sources));
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
@@ -990,12 +1070,18 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
 	compilerStack.setRemappings(move(_inputsAndSettings.remappings));
 	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
+	compilerStack.setCompilerThreads(_inputsAndSettings.parallelism);
 	compilerStack.setRevertStringBehaviour(_inputsAndSettings.revertStrings);
 	compilerStack.setLibraries(_inputsAndSettings.libraries);
 	compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
 	compilerStack.setMetadataHash(_inputsAndSettings.metadataHash);
-	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
-	compilerStack.setModelCheckerSettings(_inputsAndSettings.modelCheckerSettings);
+	map<string, set<string>> const requestedContracts = requestedContractNames(_inputsAndSettings.outputSelection);
+	compilerStack.setRequestedContractNames(requestedContracts);
+	ModelCheckerSettings modelCheckerSettings = _inputsAndSettings.modelCheckerSettings;
+	// Solver answers are only cached next to the compilation cache, the input cannot choose a directory.
+	if (m_compilationCache)
+		modelCheckerSettings.cacheDirectory = m_compilationCache->directory() / "smt";
+	compilerStack.setModelCheckerSettings(modelCheckerSettings);
 
 	compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
 	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
@@ -1005,9 +1091,49 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 
 	bool const binariesRequested = isBinaryRequested(_inputsAndSettings.outputSelection);
 
+	/// Output of contracts served from the compilation cache, by fully qualified name.
+	map<string, Json::Value> cachedContracts;
+	/// Cache keys of the requested contracts that were compiled and whose output is to be stored.
+	map<string, util::h256> uncachedContractKeys;
+	bool allRequestedContractsCached = false;
+
 	try
 	{
-		if (binariesRequested)
+		if (binariesRequested && m_compilationCache)
+		{
+			if (compilerStack.parseAndAnalyze())
+			{
+				map<string, set<string>> uncachedContracts;
+				for (string const& contractName: compilerStack.contractNames())
+				{
+					ContractDefinition const& contract = compilerStack.contractDefinition(contractName);
+					if (!isRequestedContract(requestedContracts, contract.sourceUnitName(), contract.name()))
+						continue;
+
+					util::h256 key = contractCacheKey(compilerStack, contractName, _inputsAndSettings.outputSelection);
+					if (optional<Json::Value> cached = m_compilationCache->load(key))
+						cachedContracts[contractName] = move(*cached);
+					else
+					{
+						uncachedContracts[contract.sourceUnitName()].insert(contract.name());
+						uncachedContractKeys[contractName] = key;
+					}
+				}
+
+				if (uncachedContracts.empty())
+					allRequestedContractsCached = true;
+				else
+				{
+					size_t const analysisErrorCount = compilerStack.errors().size();
+					compilerStack.setRequestedContractNames(move(uncachedContracts));
+					compilerStack.compile();
+					// Diagnostics of code generation would not be reported on a cache hit.
+					if (compilerStack.errors().size() != analysisErrorCount)
+						uncachedContractKeys.clear();
+				}
+			}
+		}
+		else if (binariesRequested)
 			compilerStack.compile();
 		else
 			compilerStack.parseAndAnalyze(_inputsAndSettings.stopAfter);
@@ -1126,7 +1252,9 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	}
 
 	bool analysisPerformed = compilerStack.state() >= CompilerStack::State::AnalysisPerformed;
-	bool const compilationSuccess = compilerStack.state() == CompilerStack::State::CompilationSuccessful;
+	bool const compilationSuccess =
+		compilerStack.state() == CompilerStack::State::CompilationSuccessful ||
+		(allRequestedContractsCached && !compilerStack.hasError());
 
 	if (compilerStack.hasError() && !_inputsAndSettings.parserErrorRecovery)
 		analysisPerformed = false;
@@ -1150,6 +1278,10 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	bool const wildcardMatchesExperimental = false;
 
 	output["sources"] = Json::objectValue;
+	// ASTs that are written to _writer instead of being part of the output. They are converted
+	// to text before anything is written, so that errors during the conversion can still be
+	// reported, but without holding the much larger JSON objects in memory.
+	map<string, string> streamedASTs;
 	unsigned sourceIndex = 0;
 	if (compilerStack.state() >= CompilerStack::State::Parsed && (!compilerStack.hasError() || _inputsAndSettings.parserErrorRecovery))
 		for (string const& sourceName: compilerStack.sourceNames())
@@ -1157,7 +1289,17 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			Json::Value sourceResult = Json::objectValue;
 			sourceResult["id"] = sourceIndex++;
 			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-				sourceResult["ast"] = ASTJsonConverter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+			{
+				if (_writer)
+				{
+					ostringstream ast;
+					util::JsonCompactStreamWriter astWriter(ast);
+					ASTJsonConverter(compilerStack.state(), compilerStack.sourceIndices()).write(astWriter, compilerStack.ast(sourceName));
+					streamedASTs[sourceName] = ast.str();
+				}
+				else
+					sourceResult["ast"] = ASTJsonConverter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+			}
 			output["sources"][sourceName] = sourceResult;
 		}
 
@@ -1169,6 +1311,15 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		string file = contractName.substr(0, colon);
 		string name = contractName.substr(colon + 1);
 
+		// Cached output contains binaries, so it is only used if compilation succeeded.
+		// Otherwise the contract is reported like any other one that was not compiled.
+		if (compilationSuccess && cachedContracts.count(contractName))
+		{
+			if (!cachedContracts.at(contractName).empty())
+				contractsOutput[file][name] = cachedContracts.at(contractName);
+			continue;
+		}
+
 		// ABI, storage layout, documentation and metadata
 		Json::Value contractData(Json::objectValue);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
@@ -1256,11 +1407,47 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 				contractsOutput[file] = Json::objectValue;
 			contractsOutput[file][name] = contractData;
 		}
+
+		if (compilationSuccess && uncachedContractKeys.count(contractName))
+			m_compilationCache->store(uncachedContractKeys.at(contractName), contractData);
 	}
 	if (!contractsOutput.empty())
 		output["contracts"] = contractsOutput;
 
-	return output;
+	if (!_writer)
+		return output;
+
+	// "sources" comes last in the output, so all other members can be written before the ASTs.
+	Json::Value sources = std::move(output["sources"]);
+	output.removeMember("sources");
+	_writer->beginObject();
+	for (string const& name: output.getMemberNames())
+	{
+		_writer->key(name);
+		_writer->value(output[name]);
+	}
+	_writer->key("sources");
+	_writer->beginObject();
+	for (string const& sourceName: sources.getMemberNames())
+	{
+		_writer->key(sourceName);
+		_writer->beginObject();
+		if (streamedASTs.count(sourceName))
+		{
+			_writer->key("ast");
+			_writer->serializedValue(streamedASTs.at(sourceName));
+			streamedASTs.erase(sourceName);
+		}
+		for (string const& name: sources[sourceName].getMemberNames())
+		{
+			_writer->key(name);
+			_writer->value(sources[sourceName][name]);
+		}
+		_writer->endObject();
+	}
+	_writer->endObject();
+	_writer->endObject();
+	return Json::nullValue;
 }
 
 
@@ -1367,7 +1554,12 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
-	YulStringRepository::reset();
+	return compile(_input, nullptr);
+}
+
+Json::Value StandardCompiler::compile(Json::Value const& _input, util::JsonCompactStreamWriter* _writer) noexcept
+{
+	YulStringRepository::Scope yulStringScope;
 
 	try
 	{
@@ -1376,7 +1568,7 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 			return std::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
 		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
+			return compileSolidity(std::move(settings), _writer);
 		else if (settings.language == "Yul")
 			return compileYul(std::move(settings));
 		else
@@ -1428,6 +1620,41 @@ string StandardCompiler::compile(string const& _input) noexcept
 	}
 }
 
+void StandardCompiler::compile(string const& _input, ostream& _output) noexcept
+{
+	Json::Value input;
+	string errors;
+	try
+	{
+		if (!util::jsonParseStrict(_input, input, &errors))
+		{
+			util::jsonCompactPrint(formatFatalError("JSONError", errors), _output);
+			return;
+		}
+	}
+	catch (...)
+	{
+		_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		return;
+	}
+
+	util::JsonCompactStreamWriter writer(_output);
+	Json::Value output = compile(input, &writer);
+	// The output is only started once all of it has been generated, so this can only happen
+	// if writing to the stream fails.
+	if (writer.started())
+		return;
+
+	try
+	{
+		util::jsonCompactPrint(output, _output);
+	}
+	catch (...)
+	{
+		_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+	}
+}
+
 Json::Value StandardCompiler::formatFunctionDebugData(
 	map<string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
 )
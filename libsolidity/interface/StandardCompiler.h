@@ -23,12 +23,19 @@
 
 #pragma once
 
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 
 #include <optional>
+#include <ostream>
 #include <utility>
 #include <variant>
 
+namespace solidity::util
+{
+class JsonCompactStreamWriter;
+}
+
 namespace solidity::frontend
 {
 
@@ -57,6 +64,16 @@ public:
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Same as above, but writes the output to @a _output. The ASTs of Solidity sources are
+	/// converted to text one at a time instead of building the whole output in memory.
+	/// Internal errors are reported in the output like in the other variants.
+	void compile(std::string const& _input, std::ostream& _output) noexcept;
+
+	/// Makes Solidity compilations store the output of every requested contract in @a _directory
+	/// and reuse it in later compilations as long as the contract's metadata, the set of source
+	/// units and the output selection are unchanged. Contracts that are served from the cache are
+	/// not compiled; analysis is always performed.
+	void enableCompilationCache(boost::filesystem::path _directory) { m_compilationCache.emplace(std::move(_directory)); }
 
 	static Json::Value formatFunctionDebugData(
 		std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
@@ -81,16 +98,23 @@ private:
 		Json::Value outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		unsigned parallelism = 1;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Performs the compilation for compile(Json::Value const&). If @a _writer is given,
+	/// Solidity compilations write their output to it and return null.
+	Json::Value compile(Json::Value const& _input, util::JsonCompactStreamWriter* _writer) noexcept;
+
+	/// If @a _writer is given, writes the output including the ASTs to it and returns null.
+	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings, util::JsonCompactStreamWriter* _writer = nullptr);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
+	std::optional<CompilationCache> m_compilationCache;
 };
 
 }
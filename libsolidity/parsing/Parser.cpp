@@ -66,7 +66,9 @@ public:
 		solAssert(m_location.source, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		ASTPointer<NodeType> node = make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		m_parser.recordNode(node);
+		return node;
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -144,6 +146,14 @@ ASTPointer<SourceUnit> Parser::parse(shared_ptr<Scanner> const& _scanner)
 	}
 }
 
+void Parser::shiftNodeIDs(int64_t _offset)
+{
+	solAssert(m_recordNodes && _offset >= 0, "");
+	for (ASTPointer<ASTNode> const& node: m_recordedNodes)
+		node->m_id += static_cast<size_t>(_offset);
+	m_recordedNodes.clear();
+}
+
 void Parser::parsePragmaVersion(SourceLocation const& _location, vector<Token> const& _tokens, vector<string> const& _literals)
 {
 	SemVerMatchExpressionParser parser(_tokens, _literals);
@@ -1300,7 +1310,9 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 		BOOST_THROW_EXCEPTION(FatalError());
 
 	location.end = block->debugData->location.end;
-	return make_shared<InlineAssembly>(nextID(), location, _docString, dialect, block);
+	ASTPointer<InlineAssembly> inlineAssembly = make_shared<InlineAssembly>(nextID(), location, _docString, dialect, block);
+	recordNode(inlineAssembly);
+	return inlineAssembly;
 }
 
 ASTPointer<IfStatement> Parser::parseIfStatement(ASTPointer<ASTString> const& _docString)
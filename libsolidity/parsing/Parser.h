@@ -49,6 +49,15 @@ public:
 
 	ASTPointer<SourceUnit> parse(std::shared_ptr<langutil::Scanner> const& _scanner);
 
+	/// Makes the parser remember the nodes it creates, so that their IDs can be moved with
+	/// shiftNodeIDs. This allows parsing source units with separate parsers and assigning
+	/// the IDs a single parser would have assigned afterwards.
+	void recordNodes() { m_recordNodes = true; }
+	/// @returns the ID of the last node created by this parser.
+	int64_t lastNodeID() const { return m_currentNodeID; }
+	/// Adds @a _offset to the IDs of all nodes recorded so far and forgets them.
+	void shiftNodeIDs(int64_t _offset);
+
 private:
 	class ASTNodeFactory;
 
@@ -187,6 +196,13 @@ private:
 
 	/// Returns the next AST node ID
 	int64_t nextID() { return ++m_currentNodeID; }
+	/// Remembers @a _node for shiftNodeIDs if requested. The node is kept alive until then, since
+	/// some nodes created during look-ahead are discarded again while parsing.
+	void recordNode(ASTPointer<ASTNode> _node)
+	{
+		if (m_recordNodes)
+			m_recordedNodes.push_back(std::move(_node));
+	}
 
 	std::pair<LookAheadInfo, IndexAccessedPath> tryParseIndexAccessedPath();
 	/// Performs limited look-ahead to distinguish between variable declaration and expression statement.
@@ -216,6 +232,8 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	bool m_recordNodes = false;
+	std::vector<ASTPointer<ASTNode>> m_recordedNodes;
 };
 
 }
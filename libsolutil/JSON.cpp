@@ -23,6 +23,8 @@
 #include <libsolutil/JSON.h>
 
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/Assertions.h>
+#include <libsolutil/Exceptions.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
@@ -64,6 +66,13 @@ public:
 	}
 };
 
+/// Serialise the JSON object (@a _input) with specific builder (@a _builder) to @a _output.
+void print(Json::Value const& _input, Json::StreamWriterBuilder const& _builder, ostream& _output)
+{
+	unique_ptr<Json::StreamWriter> writer(_builder.newStreamWriter());
+	writer->write(_input, &_output);
+}
+
 /// Serialise the JSON object (@a _input) with specific builder (@a _builder)
 /// \param _input JSON input string
 /// \param _builder StreamWriterBuilder that is used to create new Json::StreamWriter
@@ -71,8 +80,7 @@ public:
 string print(Json::Value const& _input, Json::StreamWriterBuilder const& _builder)
 {
 	stringstream stream;
-	unique_ptr<Json::StreamWriter> writer(_builder.newStreamWriter());
-	writer->write(_input, &stream);
+	print(_input, _builder, stream);
 	return stream.str();
 }
 
@@ -122,11 +130,99 @@ string jsonPrettyPrint(Json::Value const& _input)
 	return result;
 }
 
-string jsonCompactPrint(Json::Value const& _input)
+namespace
+{
+
+StreamWriterBuilder const& compactWriterBuilder()
 {
 	static map<string, Json::Value> settings{{"indentation", ""}};
 	static StreamWriterBuilder writerBuilder(settings);
-	return print(_input, writerBuilder);
+	return writerBuilder;
+}
+
+}
+
+string jsonCompactPrint(Json::Value const& _input)
+{
+	return print(_input, compactWriterBuilder());
+}
+
+void jsonCompactPrint(Json::Value const& _input, ostream& _output)
+{
+	print(_input, compactWriterBuilder(), _output);
+}
+
+void JsonCompactStreamWriter::beginObject()
+{
+	beginValue();
+	m_output << '{';
+	m_containers.push_back({true, true, {}});
+}
+
+void JsonCompactStreamWriter::endObject()
+{
+	assertThrow(!m_containers.empty() && m_containers.back().isObject && !m_afterKey, Exception, "");
+	m_containers.pop_back();
+	m_output << '}';
+}
+
+void JsonCompactStreamWriter::beginArray()
+{
+	beginValue();
+	m_output << '[';
+	m_containers.push_back({false, true, {}});
+}
+
+void JsonCompactStreamWriter::endArray()
+{
+	assertThrow(!m_containers.empty() && !m_containers.back().isObject, Exception, "");
+	m_containers.pop_back();
+	m_output << ']';
+}
+
+void JsonCompactStreamWriter::key(string const& _name)
+{
+	assertThrow(!m_containers.empty() && m_containers.back().isObject && !m_afterKey, Exception, "");
+	Container& object = m_containers.back();
+	assertThrow(object.empty || object.lastKey < _name, Exception, "Members not written in order.");
+	if (!object.empty)
+		m_output << ',';
+	object.empty = false;
+	object.lastKey = _name;
+	// Names are escaped in the same way as string values.
+	jsonCompactPrint(Json::Value(_name), m_output);
+	m_output << ':';
+	m_afterKey = true;
+}
+
+void JsonCompactStreamWriter::value(Json::Value const& _value)
+{
+	beginValue();
+	jsonCompactPrint(_value, m_output);
+}
+
+void JsonCompactStreamWriter::serializedValue(string const& _json)
+{
+	beginValue();
+	m_output << _json;
+}
+
+void JsonCompactStreamWriter::beginValue()
+{
+	if (m_containers.empty())
+		assertThrow(!m_started, Exception, "Only one document can be written.");
+	else if (m_containers.back().isObject)
+	{
+		assertThrow(m_afterKey, Exception, "Missing member name.");
+		m_afterKey = false;
+	}
+	else
+	{
+		if (!m_containers.back().empty)
+			m_output << ',';
+		m_containers.back().empty = false;
+	}
+	m_started = true;
 }
 
 bool jsonParseStrict(string const& _input, Json::Value& _json, string* _errs /* = nullptr */)
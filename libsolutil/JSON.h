@@ -25,7 +25,9 @@
 
 #include <json/json.h>
 
+#include <ostream>
 #include <string>
+#include <vector>
 
 namespace solidity::util
 {
@@ -39,6 +41,52 @@ std::string jsonPrettyPrint(Json::Value const& _input);
 /// Serialise the JSON object (@a _input) without indentation
 std::string jsonCompactPrint(Json::Value const& _input);
 
+/// Serialise the JSON object (@a _input) without indentation directly to @a _output.
+void jsonCompactPrint(Json::Value const& _input, std::ostream& _output);
+
+/**
+ * Writes a JSON document piece by piece to a stream, in the same format as jsonCompactPrint.
+ * Allows writing large documents without building them in memory as a whole.
+ * The members of an object have to be written in the order of their names, which is the order
+ * jsonCompactPrint uses.
+ */
+class JsonCompactStreamWriter
+{
+public:
+	explicit JsonCompactStreamWriter(std::ostream& _output): m_output(_output) {}
+
+	void beginObject();
+	void endObject();
+	void beginArray();
+	void endArray();
+	/// Writes the name of the next member of the current object.
+	void key(std::string const& _name);
+	/// Writes @a _value as the next array element, the value of the member named last
+	/// or as the whole document.
+	void value(Json::Value const& _value);
+	/// Writes @a _json, a complete document written by another writer, in the same way as value().
+	void serializedValue(std::string const& _json);
+
+	/// @returns true if anything has been written.
+	bool started() const { return m_started; }
+
+private:
+	/// Writes the separator in front of the next value.
+	void beginValue();
+
+	struct Container
+	{
+		bool isObject = false;
+		bool empty = true;
+		std::string lastKey;
+	};
+
+	std::ostream& m_output;
+	std::vector<Container> m_containers;
+	bool m_started = false;
+	bool m_afterKey = false;
+};
+
 /// Parse a JSON string (@a _input) with enabled strict-mode and writes resulting JSON object to (@a _json)
 /// \param _input JSON input string
 /// \param _json [out] resulting JSON object
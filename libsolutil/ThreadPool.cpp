@@ -0,0 +1,96 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ThreadPool.h>
+
+using namespace std;
+using namespace solidity::util;
+
+ThreadPool::ThreadPool(size_t _threads)
+{
+	for (size_t i = 1; i < _threads; ++i)
+		m_workers.emplace_back([this]() { work(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_tasksAvailable.notify_all();
+	for (thread& worker: m_workers)
+		worker.join();
+}
+
+void ThreadPool::run(size_t _count, function<void(size_t)> const& _task)
+{
+	unique_lock<mutex> lock(m_mutex);
+	m_task = &_task;
+	m_exceptions.assign(_count, nullptr);
+	m_count = _count;
+	m_next = 0;
+	m_finished = 0;
+	if (_count > 1)
+		m_tasksAvailable.notify_all();
+
+	runTasks(lock);
+	m_batchDone.wait(lock, [&]() { return m_finished == m_count; });
+	m_task = nullptr;
+
+	vector<exception_ptr> exceptions = move(m_exceptions);
+	lock.unlock();
+	for (exception_ptr const& exception: exceptions)
+		if (exception)
+			rethrow_exception(exception);
+}
+
+void ThreadPool::work()
+{
+	unique_lock<mutex> lock(m_mutex);
+	while (true)
+	{
+		m_tasksAvailable.wait(lock, [&]() { return m_stopping || (m_task && m_next < m_count); });
+		if (m_stopping)
+			return;
+		runTasks(lock);
+	}
+}
+
+void ThreadPool::runTasks(unique_lock<mutex>& _lock)
+{
+	while (m_task && m_next < m_count)
+	{
+		size_t index = m_next++;
+		function<void(size_t)> const& task = *m_task;
+		_lock.unlock();
+		exception_ptr exception;
+		try
+		{
+			task(index);
+		}
+		catch (...)
+		{
+			exception = current_exception();
+		}
+		_lock.lock();
+		m_exceptions[index] = exception;
+		if (++m_finished == m_count)
+			m_batchDone.notify_all();
+	}
+}
@@ -0,0 +1,75 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Fixed set of threads that runs batches of independent tasks.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Fixed set of threads that runs batches of independent tasks.
+ * The threads are started once and reused for every batch, the calling thread takes part
+ * in running the tasks of a batch.
+ */
+class ThreadPool
+{
+public:
+	/// Creates a pool that runs tasks on @a _threads threads, including the calling thread.
+	explicit ThreadPool(size_t _threads);
+	~ThreadPool();
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	/// @returns the number of threads tasks are run on, including the calling thread.
+	size_t threads() const { return m_workers.size() + 1; }
+
+	/// Calls @a _task with every index from 0 to @a _count - 1 and returns once all calls are done.
+	/// The calls are distributed over the threads of the pool in no particular order.
+	/// If calls throw, the exception of the call with the smallest index is rethrown.
+	/// Must not be called from a task.
+	void run(size_t _count, std::function<void(size_t)> const& _task);
+
+private:
+	void work();
+	/// Runs tasks of the current batch until none are left. Expects @a _lock to be locked.
+	void runTasks(std::unique_lock<std::mutex>& _lock);
+
+	std::mutex m_mutex;
+	std::condition_variable m_tasksAvailable;
+	std::condition_variable m_batchDone;
+	std::function<void(size_t)> const* m_task = nullptr;
+	std::vector<std::exception_ptr> m_exceptions;
+	size_t m_count = 0;
+	size_t m_next = 0;
+	size_t m_finished = 0;
+	bool m_stopping = false;
+	std::vector<std::thread> m_workers;
+};
+
+}
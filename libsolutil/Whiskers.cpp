@@ -26,11 +26,260 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity::util;
 
+namespace
+{
+
+/// Template text split into literal text and tags. Templates are parsed once and
+/// cached by their text, since the structure does not depend on the parameter values.
+struct ParsedTemplate
+{
+	struct Part
+	{
+		enum class Kind { Text, Value, List, Condition };
+		Kind kind;
+		/// The literal text for Kind::Text, the name of the parameter otherwise.
+		/// For conditions on string parameters, the name includes the leading "+".
+		string text;
+		/// The body of a list or the first branch of a condition.
+		unique_ptr<ParsedTemplate const> body;
+		/// The second branch of a condition, if present.
+		unique_ptr<ParsedTemplate const> elseBody;
+	};
+
+	/// The text of the template, used in error messages.
+	string source;
+	vector<Part> parts;
+};
+
+bool isParameterChar(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' ||
+		_c == '$' ||
+		_c == '-';
+}
+
+/// @returns the end of the (possibly empty) sequence of parameter characters starting at @a _pos.
+size_t parameterEnd(string const& _text, size_t _pos)
+{
+	while (_pos < _text.size() && isParameterChar(_text[_pos]))
+		++_pos;
+	return _pos;
+}
+
+/// Parses a template. Tags are recognised exactly like the regular expression
+///   <(P)>|<#(P)>((?:.|\r|\n)*?)</\2>|<\?(\+?P)>((?:.|\r|\n)*?)(<!\4>((?:.|\r|\n)*?))?</\4>
+/// with P = [a-zA-Z0-9_$-]+ that was previously used to search the template:
+/// the leftmost match wins and bodies end at the first closing tag of the same name.
+unique_ptr<ParsedTemplate const> parseTemplate(string _source)
+{
+	auto result = make_unique<ParsedTemplate>();
+	result->source = move(_source);
+	string const& text = result->source;
+
+	size_t textStart = 0;
+	size_t pos = text.find('<');
+	while (pos != string::npos)
+	{
+		optional<ParsedTemplate::Part> part;
+		size_t matchEnd = pos;
+		char const kindChar = pos + 1 < text.size() ? text[pos + 1] : '\0';
+		if (isParameterChar(kindChar))
+		{
+			size_t nameEnd = parameterEnd(text, pos + 1);
+			if (nameEnd < text.size() && text[nameEnd] == '>')
+			{
+				part = ParsedTemplate::Part{
+					ParsedTemplate::Part::Kind::Value,
+					text.substr(pos + 1, nameEnd - pos - 1),
+					nullptr,
+					nullptr
+				};
+				matchEnd = nameEnd + 1;
+			}
+		}
+		else if (kindChar == '#' || kindChar == '?')
+		{
+			size_t nameStart = pos + 2;
+			size_t parameterStart = nameStart;
+			if (kindChar == '?' && parameterStart < text.size() && text[parameterStart] == '+')
+				++parameterStart;
+			size_t nameEnd = parameterEnd(text, parameterStart);
+			if (nameEnd > parameterStart && nameEnd < text.size() && text[nameEnd] == '>')
+			{
+				string name = text.substr(nameStart, nameEnd - nameStart);
+				string closeTag = "</" + name + ">";
+				size_t bodyStart = nameEnd + 1;
+				size_t closePos = text.find(closeTag, bodyStart);
+				if (closePos != string::npos)
+				{
+					matchEnd = closePos + closeTag.size();
+					if (kindChar == '#')
+						part = ParsedTemplate::Part{
+							ParsedTemplate::Part::Kind::List,
+							move(name),
+							parseTemplate(text.substr(bodyStart, closePos - bodyStart)),
+							nullptr
+						};
+					else
+					{
+						string elseTag = "<!" + name + ">";
+						size_t elsePos = text.find(elseTag, bodyStart);
+						if (elsePos < closePos)
+							part = ParsedTemplate::Part{
+								ParsedTemplate::Part::Kind::Condition,
+								move(name),
+								parseTemplate(text.substr(bodyStart, elsePos - bodyStart)),
+								parseTemplate(text.substr(
+									elsePos + elseTag.size(),
+									closePos - elsePos - elseTag.size()
+								))
+							};
+						else
+							part = ParsedTemplate::Part{
+								ParsedTemplate::Part::Kind::Condition,
+								move(name),
+								parseTemplate(text.substr(bodyStart, closePos - bodyStart)),
+								nullptr
+							};
+					}
+				}
+			}
+		}
+
+		if (part)
+		{
+			if (pos > textStart)
+				result->parts.emplace_back(ParsedTemplate::Part{
+					ParsedTemplate::Part::Kind::Text,
+					text.substr(textStart, pos - textStart),
+					nullptr,
+					nullptr
+				});
+			result->parts.emplace_back(move(*part));
+			textStart = matchEnd;
+			pos = text.find('<', matchEnd);
+		}
+		else
+			pos = text.find('<', pos + 1);
+	}
+	if (textStart < text.size())
+		result->parts.emplace_back(ParsedTemplate::Part{
+			ParsedTemplate::Part::Kind::Text,
+			text.substr(textStart),
+			nullptr,
+			nullptr
+		});
+	return result;
+}
+
+/// @returns the parsed version of @a _template, parsing it only if it was not seen before.
+shared_ptr<ParsedTemplate const> cachedParsedTemplate(string const& _template)
+{
+	static mutex cacheMutex;
+	static unordered_map<string, shared_ptr<ParsedTemplate const>> cache;
+
+	lock_guard<mutex> lock(cacheMutex);
+	shared_ptr<ParsedTemplate const>& parsed = cache[_template];
+	if (!parsed)
+		parsed = parseTemplate(_template);
+	return parsed;
+}
+
+/// Joins the two maps throwing an exception if two keys are equal.
+Whiskers::StringMap joinMaps(Whiskers::StringMap const& _a, Whiskers::StringMap const& _b)
+{
+	Whiskers::StringMap ret = _a;
+	for (auto const& x: _b)
+		assertThrow(
+			ret.insert(x).second,
+			WhiskersError,
+			"Parameter collision"
+		);
+	return ret;
+}
+
+void renderTemplate(
+	ParsedTemplate const& _template,
+	Whiskers::StringMap const& _parameters,
+	map<string, bool> const& _conditions,
+	Whiskers::StringListMap const& _listParameters,
+	string& _output
+)
+{
+	for (ParsedTemplate::Part const& part: _template.parts)
+		switch (part.kind)
+		{
+		case ParsedTemplate::Part::Kind::Text:
+			_output += part.text;
+			break;
+		case ParsedTemplate::Part::Kind::Value:
+		{
+			auto value = _parameters.find(part.text);
+			assertThrow(
+				value != _parameters.end(),
+				WhiskersError,
+				"Value for tag " + part.text + " not provided.\n" +
+				"Template:\n" +
+				_template.source
+			);
+			_output += value->second;
+			break;
+		}
+		case ParsedTemplate::Part::Kind::List:
+		{
+			auto list = _listParameters.find(part.text);
+			assertThrow(
+				list != _listParameters.end(),
+				WhiskersError, "List parameter " + part.text + " not set."
+			);
+			for (auto const& parameters: list->second)
+				renderTemplate(*part.body, joinMaps(_parameters, parameters), _conditions, {}, _output);
+			break;
+		}
+		case ParsedTemplate::Part::Kind::Condition:
+		{
+			bool conditionValue = false;
+			if (part.text[0] == '+')
+			{
+				string tag = part.text.substr(1);
+				auto value = _parameters.find(tag);
+				assertThrow(
+					value != _parameters.end(),
+					WhiskersError, "Tag " + tag + " used as condition but was not set."
+				);
+				conditionValue = !value->second.empty();
+			}
+			else
+			{
+				auto condition = _conditions.find(part.text);
+				assertThrow(
+					condition != _conditions.end(),
+					WhiskersError, "Condition parameter " + part.text + " not set."
+				);
+				conditionValue = condition->second;
+			}
+			if (ParsedTemplate const* branch = conditionValue ? part.body.get() : part.elseBody.get())
+				renderTemplate(*branch, _parameters, _conditions, _listParameters, _output);
+			break;
+		}
+		}
+}
+
+}
+
 Whiskers::Whiskers(string _template):
 	m_template(move(_template))
 {
@@ -71,14 +320,17 @@ Whiskers& Whiskers::operator()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	shared_ptr<ParsedTemplate const> parsed = cachedParsedTemplate(m_template);
+	string result;
+	result.reserve(m_template.size());
+	renderTemplate(*parsed, m_parameters, m_conditions, m_listParameters, result);
+	return result;
 }
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && all_of(_parameter.begin(), _parameter.end(), isParameterChar),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -115,116 +367,3 @@ void Whiskers::checkTemplateContainsTags(string const& _parameter, vector<string
 		);
 	}
 }
-
-namespace
-{
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
-{
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
-	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
-	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
-}
-
-string Whiskers::replace(
-	string const& _template,
-	StringMap const& _parameters,
-	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
-)
-{
-	static regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
-	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
-		{
-			assertThrow(
-				_parameters.count(tagName),
-				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
-				"Template:\n" +
-				_template
-			);
-			return _parameters.at(tagName);
-		}
-		else if (!listName.empty())
-		{
-			string templ(_match[3]);
-			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
-			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
-		}
-		else
-		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
-			bool conditionValue = false;
-			if (conditionName[0] == '+')
-			{
-				string tag = conditionName.substr(1);
-				assertThrow(
-					_parameters.count(tag),
-					WhiskersError, "Tag " + tag + " used as condition but was not set."
-				);
-				conditionValue = !_parameters.at(tag).empty();
-			}
-			else
-			{
-				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
-				);
-				conditionValue = _conditions.at(conditionName);
-			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
-		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
-}
-
@@ -0,0 +1,155 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * String abstraction that avoids copies.
+ */
+
+#include <libyul/YulString.h>
+
+using namespace std;
+using namespace solidity::yul;
+
+namespace
+{
+
+struct ResetCallbacks
+{
+	mutex callbacksMutex;
+	vector<function<void()>> callbacks;
+};
+
+ResetCallbacks& resetCallbacks()
+{
+	static ResetCallbacks callbacks;
+	return callbacks;
+}
+
+/// Repository bound to the current thread by a Scope.
+thread_local shared_ptr<YulStringRepository> currentRepository;
+
+string const* findInShard(
+	unordered_multimap<uint64_t, string const*> const& _hashToString,
+	string const& _string,
+	uint64_t _hash
+)
+{
+	auto range = _hashToString.equal_range(_hash);
+	for (auto it = range.first; it != range.second; ++it)
+		if (*it->second == _string)
+			return it->second;
+	return nullptr;
+}
+
+}
+
+YulStringRepository& YulStringRepository::instance()
+{
+	if (currentRepository)
+		return *currentRepository;
+	return *global();
+}
+
+shared_ptr<YulStringRepository> YulStringRepository::current()
+{
+	if (currentRepository)
+		return currentRepository;
+	return global();
+}
+
+shared_ptr<YulStringRepository> const& YulStringRepository::global()
+{
+	static shared_ptr<YulStringRepository> const repository{new YulStringRepository()};
+	return repository;
+}
+
+shared_ptr<YulStringRepository> YulStringRepository::create()
+{
+	return shared_ptr<YulStringRepository>(new YulStringRepository());
+}
+
+string const* YulStringRepository::find(string const& _string, uint64_t _hash)
+{
+	Shard& s = shard(_hash);
+	shared_lock<shared_mutex> lock(s.mutex);
+	return findInShard(s.hashToString, _string, _hash);
+}
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(string const& _string)
+{
+	if (_string.empty())
+		return { nullptr, emptyHash() };
+	uint64_t h = hash(_string);
+	if (this != global().get())
+		if (string const* id = global()->find(_string, h))
+			return Handle{id, h};
+
+	if (string const* id = find(_string, h))
+		return Handle{id, h};
+
+	Shard& s = shard(h);
+	unique_lock<shared_mutex> lock(s.mutex);
+	// Another thread might have inserted the string in the meantime.
+	if (string const* id = findInShard(s.hashToString, _string, h))
+		return Handle{id, h};
+	string const* id = &s.strings.emplace_back(_string);
+	s.hashToString.emplace(h, id);
+	return Handle{id, h};
+}
+
+void YulStringRepository::reset()
+{
+	vector<function<void()>> callbacks;
+	{
+		lock_guard<mutex> lock(resetCallbacks().callbacksMutex);
+		callbacks = resetCallbacks().callbacks;
+	}
+	// The callbacks are run without holding the lock, since they might need
+	// to acquire locks that are held while registering a callback.
+	for (auto const& cb: callbacks)
+		cb();
+	for (Shard& s: global()->m_shards)
+	{
+		unique_lock<shared_mutex> lock(s.mutex);
+		s.hashToString.clear();
+		s.strings.clear();
+		s.strings.shrink_to_fit();
+	}
+}
+
+YulStringRepository::ResetCallback::ResetCallback(function<void()> _fun)
+{
+	lock_guard<mutex> lock(resetCallbacks().callbacksMutex);
+	resetCallbacks().callbacks.emplace_back(move(_fun));
+}
+
+YulStringRepository::Scope::Scope():
+	Scope(currentRepository ? currentRepository : create())
+{
+}
+
+YulStringRepository::Scope::Scope(shared_ptr<YulStringRepository> _repository):
+	m_repository(move(_repository)),
+	m_previous(move(currentRepository))
+{
+	currentRepository = m_repository;
+}
+
+YulStringRepository::Scope::~Scope()
+{
+	currentRepository = move(m_previous);
+}
@@ -21,10 +21,14 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <array>
+#include <deque>
 #include <memory>
-#include <vector>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <functional>
 
 namespace solidity::yul
@@ -32,40 +36,45 @@ namespace solidity::yul
 
 /// Repository for YulStrings.
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
-/// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
+/// A Handle consists of an ID (the address of the string data, which is potentially
 /// non-deterministic) and a deterministic string hash.
+/// The repository is safe to use from multiple threads: strings are distributed over
+/// shards by their hash and each shard is guarded by its own reader-writer lock, while
+/// resolving a handle back to its string does not access the repository at all.
+///
+/// There is a global repository, which is used outside of scopes, and every compilation
+/// can have its own repository, which is bound to a thread by a Scope. The strings of such a
+/// repository are released together with it. Strings that are already in the global repository
+/// are not added to the repository of a compilation again, and strings of different
+/// repositories still compare equal by content.
 class YulStringRepository
 {
 public:
 	struct Handle
 	{
-		size_t id;
+		/// Address of the string data owned by the repository, nullptr for the empty string.
+		std::string const* id;
 		std::uint64_t hash;
 	};
 
-	static YulStringRepository& instance()
+	/// @returns the repository bound to the current thread, or the global repository.
+	static YulStringRepository& instance();
+	/// @returns the repository bound to the current thread, or the global repository, so that
+	/// it can be bound to other threads that work on the same objects.
+	static std::shared_ptr<YulStringRepository> current();
+	/// @returns the global repository. Objects that are shared between compilations, like the
+	/// dialects, have to create their strings in this repository.
+	static std::shared_ptr<YulStringRepository> const& global();
+	/// @returns a new repository for the strings of a compilation.
+	static std::shared_ptr<YulStringRepository> create();
+
+	Handle stringToHandle(std::string const& _string);
+	static std::string const& idToString(std::string const* _id)
 	{
-		static YulStringRepository inst;
-		return inst;
+		static std::string const emptyString;
+		return _id ? *_id : emptyString;
 	}
 
-	Handle stringToHandle(std::string const& _string)
-	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
-	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
-
 	static std::uint64_t hash(std::string const& v)
 	{
 		// FNV hash - can be replaced by a better one, e.g. xxhash64
@@ -79,45 +88,65 @@ public:
 		return hash;
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
-	/// Clear the repository.
-	/// Use with care - there cannot be any dangling YulString references.
+	/// Clear the global repository.
+	/// Use with care - there cannot be any dangling YulString references and no other
+	/// thread may use YulStrings at the same time.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
-	static void reset()
-	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
-	}
+	static void reset();
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
 	{
-		ResetCallback(std::function<void()> _fun)
-		{
-			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
-		}
+		ResetCallback(std::function<void()> _fun);
+	};
+	/// Binds a repository to the current thread for the lifetime of the scope.
+	/// Scopes on the same thread have to be nested.
+	class Scope
+	{
+	public:
+		/// Binds a new repository, unless a repository is bound to the current thread already.
+		Scope();
+		/// Binds @a _repository, e.g. to share the repository of a compilation with worker threads.
+		explicit Scope(std::shared_ptr<YulStringRepository> _repository);
+		~Scope();
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+
+		std::shared_ptr<YulStringRepository> const& repository() const { return m_repository; }
+
+	private:
+		std::shared_ptr<YulStringRepository> m_repository;
+		std::shared_ptr<YulStringRepository> m_previous;
 	};
 
 private:
+	static size_t constexpr ShardBits = 6;
+
+	struct Shard
+	{
+		std::shared_mutex mutex;
+		/// Storage of the strings of this shard. Elements are never moved,
+		/// so that their addresses can be used as IDs.
+		std::deque<std::string> strings;
+		std::unordered_multimap<std::uint64_t, std::string const*> hashToString;
+	};
+
 	YulStringRepository() = default;
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
 
-	static std::vector<std::function<void()>>& resetCallbacks()
-	{
-		static std::vector<std::function<void()>> callbacks;
-		return callbacks;
-	}
+	Shard& shard(std::uint64_t _hash) { return m_shards[_hash >> (64 - ShardBits)]; }
+	/// @returns the ID of @a _string if it is in this repository, nullptr otherwise.
+	std::string const* find(std::string const& _string, std::uint64_t _hash);
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	std::array<Shard, size_t(1) << ShardBits> m_shards;
 };
 
 /// Wrapper around handles into the YulString repository.
-/// Equality of two YulStrings is determined by comparing their ID.
+/// Equality of two YulStrings is determined by comparing their ID. Only if the IDs
+/// differ but the hashes do not, which is the case for strings of different repositories,
+/// the strings are compared.
 /// The <-operator depends on the string hash and is not consistent
 /// with string comparisons (however, it is still deterministic).
 class YulString
@@ -143,21 +172,26 @@ public:
 		if (m_handle.id == _other.m_handle.id) return false;
 		return str() < _other.str();
 	}
-	/// Equality is determined based on the string ID.
-	bool operator==(YulString const& _other) const { return m_handle.id == _other.m_handle.id; }
-	bool operator!=(YulString const& _other) const { return m_handle.id != _other.m_handle.id; }
+	/// Equality is determined based on the string ID, see above.
+	bool operator==(YulString const& _other) const
+	{
+		return
+			m_handle.id == _other.m_handle.id ||
+			(m_handle.hash == _other.m_handle.hash && str() == _other.str());
+	}
+	bool operator!=(YulString const& _other) const { return !(*this == _other); }
 
-	bool empty() const { return m_handle.id == 0; }
+	bool empty() const { return m_handle.id == nullptr; }
 	std::string const& str() const
 	{
-		return YulStringRepository::instance().idToString(m_handle.id);
+		return YulStringRepository::idToString(m_handle.id);
 	}
 
 	uint64_t hash() const { return m_handle.hash; }
 
 private:
-	/// Handle of the string. Assumes that the empty string has ID zero.
-	YulStringRepository::Handle m_handle{ 0, YulStringRepository::emptyHash() };
+	/// Handle of the string. Assumes that the empty string has a null ID.
+	YulStringRepository::Handle m_handle{ nullptr, YulStringRepository::emptyHash() };
 };
 
 inline YulString operator "" _yulstring(char const* _string, std::size_t _size)
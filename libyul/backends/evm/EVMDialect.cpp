@@ -36,6 +36,7 @@
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/tail.hpp>
 
+#include <mutex>
 #include <regex>
 
 using namespace std;
@@ -326,18 +327,34 @@ bool EVMDialect::reservedIdentifier(YulString _name) const
 EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static mutex dialectsMutex;
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> lock(dialectsMutex);
+		dialects.clear();
+	}};
+	lock_guard<mutex> lock(dialectsMutex);
 	if (!dialects[_version])
+	{
+		YulStringRepository::Scope globalStrings{YulStringRepository::global()};
 		dialects[_version] = make_unique<EVMDialect>(_version, false);
+	}
 	return *dialects[_version];
 }
 
 EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static mutex dialectsMutex;
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> lock(dialectsMutex);
+		dialects.clear();
+	}};
+	lock_guard<mutex> lock(dialectsMutex);
 	if (!dialects[_version])
+	{
+		YulStringRepository::Scope globalStrings{YulStringRepository::global()};
 		dialects[_version] = make_unique<EVMDialect>(_version, true);
+	}
 	return *dialects[_version];
 }
 
@@ -363,9 +380,12 @@ SideEffects EVMDialect::sideEffectsOfInstruction(evmasm::Instruction _instructio
 BuiltinFunctionForEVM const* EVMDialect::verbatimFunction(size_t _arguments, size_t _returnVariables) const
 {
 	pair<size_t, size_t> key{_arguments, _returnVariables};
+	lock_guard<mutex> lock(m_verbatimFunctionsMutex);
 	shared_ptr<BuiltinFunctionForEVM const>& function = m_verbatimFunctions[key];
 	if (!function)
 	{
+		// The dialect is shared between compilations.
+		YulStringRepository::Scope globalStrings{YulStringRepository::global()};
 		BuiltinFunctionForEVM builtinFunction = createFunction(
 			"verbatim_" + to_string(_arguments) + "i_" + to_string(_returnVariables) + "o",
 			1 + _arguments,
@@ -497,8 +517,16 @@ BuiltinFunctionForEVM const* EVMDialectTyped::equalityFunction(YulString _type)
 EVMDialectTyped const& EVMDialectTyped::instance(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialectTyped const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static mutex dialectsMutex;
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> lock(dialectsMutex);
+		dialects.clear();
+	}};
+	lock_guard<mutex> lock(dialectsMutex);
 	if (!dialects[_version])
+	{
+		YulStringRepository::Scope globalStrings{YulStringRepository::global()};
 		dialects[_version] = make_unique<EVMDialectTyped>(_version, true);
+	}
 	return *dialects[_version];
 }
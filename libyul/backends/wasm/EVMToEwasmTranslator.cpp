@@ -44,6 +44,8 @@
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
+#include <mutex>
+
 // The following headers are generated from the
 // yul files placed in libyul/backends/wasm/polyfill.
 
@@ -122,29 +124,47 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 
 void EVMToEwasmTranslator::parsePolyfill()
 {
-	ErrorList errors;
-	ErrorReporter errorReporter(errors);
-	shared_ptr<Scanner> scanner{make_shared<Scanner>(CharStream(
-		"{" +
-			string(solidity::yul::wasm::polyfill::Arithmetic) +
-			string(solidity::yul::wasm::polyfill::Bitwise) +
-			string(solidity::yul::wasm::polyfill::Comparison) +
-			string(solidity::yul::wasm::polyfill::Conversion) +
-			string(solidity::yul::wasm::polyfill::Interface) +
-			string(solidity::yul::wasm::polyfill::Keccak) +
-			string(solidity::yul::wasm::polyfill::Logical) +
-			string(solidity::yul::wasm::polyfill::Memory) +
-		"}", ""))};
-	m_polyfill = Parser(errorReporter, WasmDialect::instance()).parse(scanner, false);
-	if (!errors.empty())
+	static shared_ptr<Block const> polyfill;
+	static set<YulString> polyfillFunctions;
+	static mutex polyfillMutex;
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> lock(polyfillMutex);
+		polyfill.reset();
+		polyfillFunctions.clear();
+	}};
+	lock_guard<mutex> lock(polyfillMutex);
+
+	if (!polyfill)
 	{
-		string message;
-		for (auto const& err: errors)
-			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err);
-		yulAssert(false, message);
+		// The polyfill is shared between compilations.
+		YulStringRepository::Scope globalStrings{YulStringRepository::global()};
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		shared_ptr<Scanner> scanner{make_shared<Scanner>(CharStream(
+			"{" +
+				string(solidity::yul::wasm::polyfill::Arithmetic) +
+				string(solidity::yul::wasm::polyfill::Bitwise) +
+				string(solidity::yul::wasm::polyfill::Comparison) +
+				string(solidity::yul::wasm::polyfill::Conversion) +
+				string(solidity::yul::wasm::polyfill::Interface) +
+				string(solidity::yul::wasm::polyfill::Keccak) +
+				string(solidity::yul::wasm::polyfill::Logical) +
+				string(solidity::yul::wasm::polyfill::Memory) +
+			"}", ""))};
+		shared_ptr<Block> parsedPolyfill = Parser(errorReporter, WasmDialect::instance()).parse(scanner, false);
+		if (!errors.empty())
+		{
+			string message;
+			for (auto const& err: errors)
+				message += langutil::SourceReferenceFormatter::formatErrorInformation(*err);
+			yulAssert(false, message);
+		}
+
+		for (auto const& statement: parsedPolyfill->statements)
+			polyfillFunctions.insert(std::get<FunctionDefinition>(statement).name);
+		polyfill = move(parsedPolyfill);
 	}
 
-	m_polyfillFunctions.clear();
-	for (auto const& statement: m_polyfill->statements)
-		m_polyfillFunctions.insert(std::get<FunctionDefinition>(statement).name);
+	m_polyfill = polyfill;
+	m_polyfillFunctions = polyfillFunctions;
 }
@@ -36,11 +36,13 @@ public:
 	Object run(Object const& _object);
 
 private:
+	/// Retrieves the polyfill, which is parsed only once and shared by all translators
+	/// until the YulString repository is reset.
 	void parsePolyfill();
 
 	Dialect const& m_dialect;
 
-	std::shared_ptr<Block> m_polyfill;
+	std::shared_ptr<Block const> m_polyfill;
 	std::set<YulString> m_polyfillFunctions;
 };
 
@@ -24,6 +24,8 @@
 #include <libyul/AST.h>
 #include <libyul/Exceptions.h>
 
+#include <mutex>
+
 using namespace std;
 using namespace solidity::yul;
 
@@ -166,9 +168,17 @@ BuiltinFunction const* WasmDialect::equalityFunction(YulString _type) const
 WasmDialect const& WasmDialect::instance()
 {
 	static std::unique_ptr<WasmDialect> dialect;
-	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
+	static mutex dialectMutex;
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> lock(dialectMutex);
+		dialect.reset();
+	}};
+	lock_guard<mutex> lock(dialectMutex);
 	if (!dialect)
+	{
+		YulStringRepository::Scope globalStrings{YulStringRepository::global()};
 		dialect = make_unique<WasmDialect>();
+	}
 	return *dialect;
 }
 
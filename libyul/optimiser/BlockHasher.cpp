@@ -51,6 +51,24 @@ std::map<Block const*, uint64_t> BlockHasher::run(Block const& _block)
 	return result;
 }
 
+uint64_t BlockHasher::run(FunctionDefinition const& _function)
+{
+	std::map<Block const*, uint64_t> blockHashes;
+	BlockHasher functionHasher(blockHashes);
+	functionHasher.hash64(compileTimeLiteralHash("FunctionDefinition"));
+	functionHasher.hash64(_function.name.hash());
+	functionHasher.hash64(_function.parameters.size());
+	functionHasher.hash64(_function.returnVariables.size());
+	for (auto const& variables: {&_function.parameters, &_function.returnVariables})
+		for (auto const& var: *variables)
+			functionHasher.m_variableReferences[var.name] = VariableReference{
+				functionHasher.m_internalIdentifierCount++,
+				false
+			};
+	functionHasher(_function.body);
+	return functionHasher.m_hash;
+}
+
 void BlockHasher::operator()(Literal const& _literal)
 {
 	hash64(compileTimeLiteralHash("Literal"));
@@ -192,3 +210,38 @@ void BlockHasher::operator()(Block const& _block)
 	for (auto& externalReference: subBlockHasher.m_externalReferences)
 		(*this)(Identifier{{}, externalReference});
 }
+
+uint64_t ExpressionHasher::run(Expression const& _e)
+{
+	ExpressionHasher expressionHasher;
+	expressionHasher.visit(_e);
+	return expressionHasher.m_hash;
+}
+
+void ExpressionHasher::operator()(Literal const& _literal)
+{
+	hash64(compileTimeLiteralHash("Literal"));
+	// Number literals are compared by value, so hash their value
+	// instead of their representation.
+	if (_literal.kind == LiteralKind::Number)
+		for (u256 value = valueOfNumberLiteral(_literal); value != 0; value >>= 64)
+			hash64(static_cast<uint64_t>(value & u256(0xFFFFFFFFFFFFFFFFu)));
+	else
+		hash64(_literal.value.hash());
+	hash64(_literal.type.hash());
+	hash8(static_cast<uint8_t>(_literal.kind));
+}
+
+void ExpressionHasher::operator()(Identifier const& _identifier)
+{
+	hash64(compileTimeLiteralHash("Identifier"));
+	hash64(_identifier.name.hash());
+}
+
+void ExpressionHasher::operator()(FunctionCall const& _funCall)
+{
+	hash64(compileTimeLiteralHash("FunctionCall"));
+	hash64(_funCall.functionName.name.hash());
+	hash64(_funCall.arguments.size());
+	ASTWalker::operator()(_funCall);
+}
@@ -22,6 +22,7 @@
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 
 #include <libyul/optimiser/SyntacticalEquality.h>
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/SideEffects.h>
@@ -37,10 +38,20 @@ using namespace solidity::util;
 
 void CommonSubexpressionEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
-	CommonSubexpressionEliminator cse{
-		_context.dialect,
+	run(
+		_context,
+		_ast,
 		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
-	};
+	);
+}
+
+void CommonSubexpressionEliminator::run(
+	OptimiserStepContext& _context,
+	Block& _ast,
+	map<YulString, SideEffects> _functionSideEffects
+)
+{
+	CommonSubexpressionEliminator cse{_context.dialect, std::move(_functionSideEffects)};
 	cse(_ast);
 }
 
@@ -55,6 +66,7 @@ CommonSubexpressionEliminator::CommonSubexpressionEliminator(
 void CommonSubexpressionEliminator::operator()(FunctionDefinition& _fun)
 {
 	ScopedSaveAndRestore returnVariables(m_returnVariables, {});
+	ScopedSaveAndRestore valuesByHash(m_valuesByHash, {});
 
 	for (auto const& v: _fun.returnVariables)
 		m_returnVariables.insert(v.name);
@@ -103,25 +115,46 @@ void CommonSubexpressionEliminator::visit(Expression& _e)
 					_e = Identifier{debugDataOf(_e), value->name};
 		}
 	}
-	else
+	else if (optional<YulString> variable = findEquivalentVariable(_e))
+		_e = Identifier{debugDataOf(_e), *variable};
+}
+
+void CommonSubexpressionEliminator::assignValue(YulString _variable, Expression const* _value)
+{
+	DataFlowAnalyzer::assignValue(_variable, _value);
+	m_valuesByHash[ExpressionHasher::run(*_value)].emplace_back(_variable, _value);
+}
+
+optional<YulString> CommonSubexpressionEliminator::findEquivalentVariable(Expression const& _e)
+{
+	auto candidates = m_valuesByHash.find(ExpressionHasher::run(_e));
+	if (candidates == m_valuesByHash.end())
+		return nullopt;
+
+	// Drop entries of variables that have been cleared or re-assigned in the meantime.
+	auto& entries = candidates->second;
+	entries.erase(remove_if(entries.begin(), entries.end(), [&](auto const& _entry) {
+		auto it = m_value.find(_entry.first);
+		return it == m_value.end() || it->second.value != _entry.second;
+	}), entries.end());
+
+	// Among all matching variables, choose the one that comes first in m_value,
+	// so that the result does not depend on the order of assignments.
+	optional<YulString> result;
+	for (auto const& [variable, value]: entries)
 	{
-		// TODO this search is rather inefficient.
-		for (auto const& [variable, value]: m_value)
-		{
-			assertThrow(value.value, OptimizerException, "");
-			// Prevent using the default value of return variables
-			// instead of literal zeros.
-			if (
-				m_returnVariables.count(variable) &&
-				holds_alternative<Literal>(*value.value) &&
-				valueOfLiteral(get<Literal>(*value.value)) == 0
-			)
-				continue;
-			if (SyntacticallyEqual{}(_e, *value.value) && inScope(variable))
-			{
-				_e = Identifier{debugDataOf(_e), variable};
-				break;
-			}
-		}
+		if (result && !(variable < *result))
+			continue;
+		// Prevent using the default value of return variables
+		// instead of literal zeros.
+		if (
+			m_returnVariables.count(variable) &&
+			holds_alternative<Literal>(*value) &&
+			valueOfLiteral(get<Literal>(*value)) == 0
+		)
+			continue;
+		if (SyntacticallyEqual{}(_e, *value) && inScope(variable))
+			result = variable;
 	}
+	return result;
 }
@@ -25,7 +25,10 @@
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 #include <libyul/optimiser/OptimiserStep.h>
 
+#include <optional>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -44,6 +47,13 @@ class CommonSubexpressionEliminator: public DataFlowAnalyzer
 public:
 	static constexpr char const* name{"CommonSubexpressionEliminator"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	/// Runs the step on @a _ast, which can be part of a larger AST, using @a _functionSideEffects
+	/// as the side effects of the functions it calls.
+	static void run(
+		OptimiserStepContext&,
+		Block& _ast,
+		std::map<YulString, SideEffects> _functionSideEffects
+	);
 
 	using DataFlowAnalyzer::operator();
 	void operator()(FunctionDefinition&) override;
@@ -58,8 +68,18 @@ protected:
 	using ASTModifier::visit;
 	void visit(Expression& _e) override;
 
+	void assignValue(YulString _variable, Expression const* _value) override;
+
 private:
+	/// @returns the variable whose current value is syntactically equal to @a _e
+	/// and can be used to replace it, if any.
+	std::optional<YulString> findEquivalentVariable(Expression const& _e);
+
 	std::set<YulString> m_returnVariables;
+	/// Variables and the values assigned to them, indexed by the hash of the value.
+	/// Entries are not removed when the value of a variable is cleared or changed,
+	/// which is instead detected by comparing against m_value on lookup.
+	std::unordered_map<uint64_t, std::vector<std::pair<YulString, Expression const*>>> m_valuesByHash;
 };
 
 }
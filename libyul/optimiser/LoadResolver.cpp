@@ -44,10 +44,25 @@ using namespace solidity::yul;
 void LoadResolver::run(OptimiserStepContext& _context, Block& _ast)
 {
 	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
+	run(
+		_context,
+		_ast,
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
+		containsMSize
+	);
+}
+
+void LoadResolver::run(
+	OptimiserStepContext& _context,
+	Block& _ast,
+	map<YulString, SideEffects> _functionSideEffects,
+	bool _containsMSize
+)
+{
 	LoadResolver{
 		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
-		containsMSize,
+		std::move(_functionSideEffects),
+		_containsMSize,
 		_context.expectedExecutionsPerDeployment
 	}(_ast);
 }
@@ -45,6 +45,14 @@ public:
 	static constexpr char const* name{"LoadResolver"};
 	/// Run the load resolver on the given complete AST.
 	static void run(OptimiserStepContext&, Block& _ast);
+	/// Run the load resolver on @a _ast, which can be part of a larger AST, using
+	/// @a _functionSideEffects and @a _containsMSize determined on the complete AST.
+	static void run(
+		OptimiserStepContext&,
+		Block& _ast,
+		std::map<YulString, SideEffects> _functionSideEffects,
+		bool _containsMSize
+	);
 
 private:
 	LoadResolver(
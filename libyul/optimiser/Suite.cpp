@@ -24,6 +24,7 @@
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/BlockFlattener.h>
+#include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/CircularReferencesPruner.h>
 #include <libyul/optimiser/ControlFlowSimplifier.h>
@@ -67,17 +68,20 @@
 #include <libyul/AsmPrinter.h>
 #include <libyul/AST.h>
 #include <libyul/Object.h>
+#include <libyul/SideEffects.h>
 
 #include <libyul/backends/wasm/WasmDialect.h>
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <libyul/CompilabilityChecker.h>
 
 #include <range/v3/view/map.hpp>
 #include <range/v3/action/remove.hpp>
 
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -89,7 +93,8 @@ void OptimiserSuite::run(
 	bool _optimizeStackAllocation,
 	string const& _optimisationSequence,
 	optional<size_t> _expectedExecutionsPerDeployment,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	size_t _threads
 )
 {
 	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
@@ -102,7 +107,14 @@ void OptimiserSuite::run(
 	)(*_object.code));
 	Block& ast = *_object.code;
 
-	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast, _expectedExecutionsPerDeployment);
+	OptimiserSuite suite(
+		_dialect,
+		reservedIdentifiers,
+		Debug::None,
+		ast,
+		_expectedExecutionsPerDeployment,
+		_threads
+	);
 
 	// Some steps depend on properties ensured by FunctionHoister, BlockFlattener, FunctionGrouper and
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
@@ -174,41 +186,39 @@ map<string, unique_ptr<OptimiserStep>> optimiserStepCollection()
 
 map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static map<string, unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			FunctionSpecializer,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			RedundantAssignEliminator,
-			ReasoningBasedSimplifier,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	static map<string, unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		BlockFlattener,
+		CircularReferencesPruner,
+		CommonSubexpressionEliminator,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		DeadCodeEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionGrouper,
+		FunctionHoister,
+		FunctionSpecializer,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		RedundantAssignEliminator,
+		ReasoningBasedSimplifier,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		StructuralSimplifier,
+		UnusedFunctionParameterPruner,
+		UnusedPruner,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	// Does not include NameSimplifier.
 	return instance;
@@ -267,6 +277,24 @@ map<char, string> const& OptimiserSuite::stepAbbreviationToNameMap()
 	return lookupTable;
 }
 
+OptimiserSuite::OptimiserSuite(
+	Dialect const& _dialect,
+	set<YulString> const& _externallyUsedIdentifiers,
+	Debug _debug,
+	Block& _ast,
+	optional<size_t> _expectedExecutionsPerDeployment,
+	size_t _threads
+):
+	m_dispenser{_dialect, _ast, _externallyUsedIdentifiers},
+	m_context{_dialect, m_dispenser, _externallyUsedIdentifiers, _expectedExecutionsPerDeployment},
+	m_debug(_debug)
+{
+	if (_threads > 1)
+		m_threadPool = make_unique<util::ThreadPool>(_threads);
+}
+
+OptimiserSuite::~OptimiserSuite() = default;
+
 void OptimiserSuite::validateSequence(string const& _stepAbbreviations)
 {
 	bool insideLoop = false;
@@ -350,7 +378,7 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 	{
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
-		allSteps().at(step)->run(m_context, _ast);
+		runStep(step, _ast);
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
@@ -375,6 +403,14 @@ void OptimiserSuite::runSequenceUntilStable(
 	if (_steps.empty())
 		return;
 
+	// For every position in the sequence that holds a function-local step, the hashes of the
+	// functions that the step left unchanged the last time it ran, by function name.
+	vector<map<YulString, uint64_t>> fixedPoints(_steps.size());
+	// Hashes of the functions in their current state, by function name. Function-local steps keep
+	// them up to date, so that consecutive function-local steps do not hash unchanged functions
+	// again. All other steps can change any function and invalidate them.
+	map<YulString, uint64_t> functionHashes;
+
 	size_t codeSize = 0;
 	for (size_t rounds = 0; rounds < maxRounds; ++rounds)
 	{
@@ -383,6 +419,203 @@ void OptimiserSuite::runSequenceUntilStable(
 			break;
 		codeSize = newSize;
 
-		runSequence(_steps, _ast);
+		if (m_debug != Debug::None)
+		{
+			runSequence(_steps, _ast);
+			continue;
+		}
+		for (size_t i = 0; i < _steps.size(); ++i)
+			if (functionLocalSteps().count(_steps[i]))
+				runFunctionLocalStep(_steps[i], _ast, fixedPoints[i], functionHashes);
+			else
+			{
+				runStep(_steps[i], _ast);
+				functionHashes.clear();
+			}
 	}
 }
+
+set<string> const& OptimiserSuite::functionLocalSteps()
+{
+	// Steps whose effect on a function only depends on the code of that function, i.e. which
+	// do not use information about other functions (like side effects or types of callees) and
+	// do not depend on the names of the variables. Running them on a function that they already
+	// left unchanged has no effect.
+	static set<string> const steps{
+		BlockFlattener::name,
+		ConditionalSimplifier::name,
+		ConditionalUnsimplifier::name,
+		ExpressionSimplifier::name,
+		ForLoopConditionIntoBody::name,
+		ForLoopConditionOutOfBody::name,
+		LiteralRematerialiser::name,
+		RedundantAssignEliminator::name,
+		SSAReverser::name,
+		StructuralSimplifier::name,
+	};
+	return steps;
+}
+
+set<string> const& OptimiserSuite::parallelSteps()
+{
+	// Steps that process each function independently of the code of the other functions apart
+	// from information that can be determined before the step runs, like the side effects of
+	// called functions, and that neither use the name dispenser nor modify other state of the
+	// context. Steps like SSATransform need fresh names and are not included.
+	static set<string> const steps = functionLocalSteps() + set<string>{
+		CommonSubexpressionEliminator::name,
+		LoadResolver::name,
+	};
+	return steps;
+}
+
+function<void(Block&)> OptimiserSuite::stepOnPartOfAST(string const& _step, Block const& _ast)
+{
+	yulAssert(parallelSteps().count(_step), "");
+	if (functionLocalSteps().count(_step))
+	{
+		OptimiserStep const& step = *allSteps().at(_step);
+		return [this, &step](Block& _part) { step.run(m_context, _part); };
+	}
+
+	// Determined on the whole AST because called functions can be in other parts.
+	map<YulString, SideEffects> functionSideEffects =
+		SideEffectsPropagator::sideEffects(m_context.dialect, CallGraphGenerator::callGraph(_ast));
+	if (_step == CommonSubexpressionEliminator::name)
+		return [this, functionSideEffects](Block& _part) {
+			CommonSubexpressionEliminator::run(m_context, _part, functionSideEffects);
+		};
+	yulAssert(_step == LoadResolver::name, "");
+	bool containsMSize = MSizeFinder::containsMSize(m_context.dialect, _ast);
+	return [this, functionSideEffects, containsMSize](Block& _part) {
+		LoadResolver::run(m_context, _part, functionSideEffects, containsMSize);
+	};
+}
+
+void OptimiserSuite::runStep(string const& _step, Block& _ast)
+{
+	if (m_threadPool && parallelSteps().count(_step))
+	{
+		vector<FunctionDefinition*> functions;
+		for (Statement& statement: _ast.statements)
+			if (auto* function = get_if<FunctionDefinition>(&statement))
+				functions.push_back(function);
+		if (functions.size() > 1)
+		{
+			runOnFunctionsInParallel(stepOnPartOfAST(_step, _ast), _ast, functions);
+			return;
+		}
+	}
+	allSteps().at(_step)->run(m_context, _ast);
+}
+
+namespace
+{
+
+/// Replaces the bodies of functions by empty blocks and puts them back later,
+/// which keeps the order of the statements intact.
+class ParkedFunctionBodies
+{
+public:
+	void park(FunctionDefinition& _function)
+	{
+		Block emptyBody{_function.body.debugData, {}};
+		m_bodies.emplace(_function.name, std::move(_function.body));
+		_function.body = std::move(emptyBody);
+	}
+	/// Puts the parked bodies back into the functions of @a _ast.
+	void restore(Block& _ast)
+	{
+		size_t restoredBodies = 0;
+		for (Statement& statement: _ast.statements)
+			if (auto* function = get_if<FunctionDefinition>(&statement))
+				if (auto parked = m_bodies.find(function->name); parked != m_bodies.end())
+				{
+					yulAssert(function->body.statements.empty(), "");
+					function->body = std::move(parked->second);
+					++restoredBodies;
+				}
+		yulAssert(restoredBodies == m_bodies.size(), "Optimiser step removed a function.");
+		m_bodies.clear();
+	}
+
+private:
+	map<YulString, Block> m_bodies;
+};
+
+}
+
+void OptimiserSuite::runFunctionLocalStep(
+	string const& _step,
+	Block& _ast,
+	map<YulString, uint64_t>& _fixedPoints,
+	map<YulString, uint64_t>& _functionHashes
+)
+{
+	// The bodies of functions that did not change since the step left them unchanged are
+	// parked while the step runs.
+	ParkedFunctionBodies parkedBodies;
+	set<YulString> pendingNames;
+	vector<FunctionDefinition*> pendingFunctions;
+	for (Statement& statement: _ast.statements)
+		if (auto* function = get_if<FunctionDefinition>(&statement))
+		{
+			auto [hash, inserted] = _functionHashes.try_emplace(function->name, 0);
+			if (inserted)
+				hash->second = BlockHasher::run(*function);
+			auto fixedPoint = _fixedPoints.find(function->name);
+			if (fixedPoint != _fixedPoints.end() && fixedPoint->second == hash->second)
+				parkedBodies.park(*function);
+			else
+			{
+				pendingNames.insert(function->name);
+				pendingFunctions.push_back(function);
+			}
+		}
+
+	if (m_threadPool && pendingFunctions.size() > 1)
+		runOnFunctionsInParallel(stepOnPartOfAST(_step, _ast), _ast, pendingFunctions);
+	else
+		allSteps().at(_step)->run(m_context, _ast);
+	parkedBodies.restore(_ast);
+
+	// The bodies of the skipped functions did not change, so their hashes are still valid.
+	for (Statement& statement: _ast.statements)
+		if (auto* function = get_if<FunctionDefinition>(&statement))
+			if (pendingNames.count(function->name))
+			{
+				uint64_t& hash = _functionHashes.at(function->name);
+				uint64_t hashAfter = BlockHasher::run(*function);
+				if (hash == hashAfter)
+					_fixedPoints[function->name] = hash;
+				else
+					_fixedPoints.erase(function->name);
+				hash = hashAfter;
+			}
+}
+
+void OptimiserSuite::runOnFunctionsInParallel(
+	function<void(Block&)> const& _step,
+	Block& _ast,
+	vector<FunctionDefinition*> const& _functions
+)
+{
+	// Each function is wrapped in a block of its own. The remaining code is processed
+	// afterwards with the bodies of the functions parked.
+	shared_ptr<YulStringRepository> yulStrings = YulStringRepository::current();
+	m_threadPool->run(_functions.size(), [&](size_t _index) {
+		YulStringRepository::Scope yulStringScope{yulStrings};
+		FunctionDefinition& function = *_functions[_index];
+		Block wrapper{function.debugData, {}};
+		wrapper.statements.emplace_back(std::move(function));
+		_step(wrapper);
+		yulAssert(wrapper.statements.size() == 1, "");
+		function = std::move(std::get<FunctionDefinition>(wrapper.statements.front()));
+	});
+
+	ParkedFunctionBodies parkedBodies;
+	for (FunctionDefinition* function: _functions)
+		parkedBodies.park(*function);
+	_step(_ast);
+	parkedBodies.restore(_ast);
+}
@@ -27,9 +27,17 @@
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <functional>
 #include <set>
 #include <string>
 #include <memory>
+#include <map>
+#include <vector>
+
+namespace solidity::util
+{
+class ThreadPool;
+}
 
 namespace solidity::yul
 {
@@ -59,6 +67,8 @@ public:
 		PrintChanges
 	};
 	/// The value nullopt for `_expectedExecutionsPerDeployment` represents creation code.
+	/// If @a _threads is greater than one, the steps in parallelSteps() are run on up to
+	/// that many functions in parallel. The result does not depend on the number of threads.
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
@@ -66,7 +76,8 @@ public:
 		bool _optimizeStackAllocation,
 		std::string const& _optimisationSequence,
 		std::optional<size_t> _expectedExecutionsPerDeployment,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		size_t _threads = 1
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -85,22 +96,50 @@ public:
 	static std::map<std::string, char> const& stepNameToAbbreviationMap();
 	static std::map<char, std::string> const& stepAbbreviationToNameMap();
 
+	~OptimiserSuite();
+
 private:
 	OptimiserSuite(
 		Dialect const& _dialect,
 		std::set<YulString> const& _externallyUsedIdentifiers,
 		Debug _debug,
 		Block& _ast,
-		std::optional<size_t> expectedExecutionsPerDeployment
-	):
-		m_dispenser{_dialect, _ast, _externallyUsedIdentifiers},
-		m_context{_dialect, m_dispenser, _externallyUsedIdentifiers, expectedExecutionsPerDeployment},
-		m_debug(_debug)
-	{}
+		std::optional<size_t> expectedExecutionsPerDeployment,
+		size_t _threads = 1
+	);
+
+	/// @returns the names of the steps that can be skipped for functions they left unchanged before.
+	static std::set<std::string> const& functionLocalSteps();
+	/// @returns the names of the steps that can be run on several functions in parallel.
+	static std::set<std::string> const& parallelSteps();
+	/// @returns a function that runs the step @a _step, which has to be one of parallelSteps(),
+	/// on a part of @a _ast. Information about the whole of @a _ast that the step needs is
+	/// determined here, so @a _ast must not be modified before the function is used.
+	std::function<void(Block&)> stepOnPartOfAST(std::string const& _step, Block const& _ast);
+	/// Runs the step @a _step on @a _ast, on several functions in parallel if possible.
+	void runStep(std::string const& _step, Block& _ast);
+	/// Runs the function-local step @a _step on @a _ast, skipping the functions whose hash matches
+	/// the one recorded in @a _fixedPoints, and records the functions the step did not change.
+	/// @a _functionHashes holds the known hashes of the current functions and is kept up to date.
+	void runFunctionLocalStep(
+		std::string const& _step,
+		Block& _ast,
+		std::map<YulString, uint64_t>& _fixedPoints,
+		std::map<YulString, uint64_t>& _functionHashes
+	);
+	/// Runs @a _step, as returned by stepOnPartOfAST(), on each of the functions in @a _functions
+	/// in parallel and then on the rest of @a _ast.
+	void runOnFunctionsInParallel(
+		std::function<void(Block&)> const& _step,
+		Block& _ast,
+		std::vector<FunctionDefinition*> const& _functions
+	);
 
 	NameDispenser m_dispenser;
 	OptimiserStepContext m_context;
 	Debug m_debug;
+	/// Threads the parallel steps are run on, only present if more than one thread is used.
+	std::unique_ptr<util::ThreadPool> m_threadPool;
 };
 
 }
@@ -129,6 +129,7 @@ static string const g_strAst = "ast";
 static string const g_strAstCompactJson = "ast-compact-json";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
+static string const g_strCacheDir = "cache-dir";
 static string const g_strCombinedJson = "combined-json";
 static string const g_strCompactJSON = "compact-format";
 static string const g_strContracts = "contracts";
@@ -159,7 +160,9 @@ static string const g_strMetadataLiteral = "metadata-literal";
 static string const g_strModelCheckerContracts = "model-checker-contracts";
 static string const g_strModelCheckerEngine = "model-checker-engine";
 static string const g_strModelCheckerTargets = "model-checker-targets";
+static string const g_strModelCheckerJobs = "model-checker-jobs";
 static string const g_strModelCheckerTimeout = "model-checker-timeout";
+static string const g_strModelCheckerCacheDir = "model-checker-cache-dir";
 static string const g_strNatspecDev = "devdoc";
 static string const g_strNatspecUser = "userdoc";
 static string const g_strNone = "none";
@@ -168,12 +171,16 @@ static string const g_strOpcodes = "opcodes";
 static string const g_strOptimize = "optimize";
 static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
+static string const g_strOpcodeOptimizerThreads = "opcode-optimizer-threads";
 static string const g_strYulOptimizations = "yul-optimizations";
+static string const g_strYulOptimizerThreads = "yul-optimizer-threads";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
 static string const g_strRevertStrings = "revert-strings";
 static string const g_strStorageLayout = "storage-layout";
 static string const g_strStopAfter = "stop-after";
+static string const g_strParserThreads = "parser-threads";
+static string const g_strJobs = "jobs";
 static string const g_strParsing = "parsing";
 
 /// Possible arguments to for --revert-strings
@@ -192,6 +199,7 @@ static string const g_strSrcMap = "srcmap";
 static string const g_strSrcMapRuntime = "srcmap-runtime";
 static string const g_strFunDebug = "function-debug";
 static string const g_strFunDebugRuntime = "function-debug-runtime";
+static string const g_strServer = "server";
 static string const g_strStandardJSON = "standard-json";
 static string const g_strStrictAssembly = "strict-assembly";
 static string const g_strSwarm = "swarm";
@@ -233,7 +241,9 @@ static string const g_argMetadataLiteral = g_strMetadataLiteral;
 static string const g_argModelCheckerContracts = g_strModelCheckerContracts;
 static string const g_argModelCheckerEngine = g_strModelCheckerEngine;
 static string const g_argModelCheckerTargets = g_strModelCheckerTargets;
+static string const g_argModelCheckerJobs = g_strModelCheckerJobs;
 static string const g_argModelCheckerTimeout = g_strModelCheckerTimeout;
+static string const g_argModelCheckerCacheDir = g_strModelCheckerCacheDir;
 static string const g_argNatspecDev = g_strNatspecDev;
 static string const g_argNatspecUser = g_strNatspecUser;
 static string const g_argOpcodes = g_strOpcodes;
@@ -891,6 +901,19 @@ General Information)").c_str(),
 			po::value<string>()->value_name("stage"),
 			"Stop execution after the given compiler stage. Valid options: \"parsing\"."
 		)
+		(
+			g_strParserThreads.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Number of threads used to parse source units and their imports in parallel. "
+			"Does not affect the output."
+		)
+		(
+			g_strJobs.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Number of threads used to optimize and assemble the contracts in parallel. "
+			"The code of the contracts is still generated on a single thread. "
+			"Does not affect the output."
+		)
 	;
 	desc.add(outputOptions);
 
@@ -901,6 +924,18 @@ General Information)").c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output."
 		)
+		(
+			g_strServer.c_str(),
+			("Switch to compiler server mode: read Standard JSON requests from standard input, one per line, "
+			"and answer each with a single line of Standard JSON output. Caches are kept between requests. "
+			"Ignores all options except --" + g_argBasePath + ", --" + g_argAllowPaths + " and --" + g_strCacheDir + ".").c_str()
+		)
+		(
+			g_strCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			("Store the output of the contracts compiled in --" + g_argStandardJSON + " or --" + g_strServer + " mode "
+			"in the given directory and reuse it for contracts whose sources and settings did not change.").c_str()
+		)
 		(
 			g_argLink.c_str(),
 			("Switch to linker mode, ignoring all options apart from --" + g_argLibraries + " "
@@ -1054,6 +1089,19 @@ General Information)").c_str(),
 			po::value<string>()->value_name("steps"),
 			"Forces yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strYulOptimizerThreads.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Number of threads the Yul optimizer uses to run the common subexpression eliminator, the load "
+			"resolver and the steps that only look at one function at a time on independent functions in parallel. "
+			"Does not affect the output."
+		)
+		(
+			g_strOpcodeOptimizerThreads.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Number of threads the opcode-based optimizer uses to optimize independent sub-assemblies "
+			"(e.g. the code of contracts created by a contract) in parallel. Does not affect the output."
+		)
 	;
 	desc.add(optimizerOptions);
 
@@ -1085,6 +1133,17 @@ General Information)").c_str(),
 			"The default is a deterministic resource limit. "
 			"A timeout of 0 means no resource/time restrictions for any query."
 		)
+		(
+			g_strModelCheckerJobs.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Set the number of solver instances the BMC engine uses to check verification targets concurrently."
+		)
+		(
+			g_strModelCheckerCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Store the answers of the SMT and Horn solvers in the given directory "
+			"and reuse them for identical queries in later runs."
+		)
 	;
 	desc.add(smtCheckerOptions);
 
@@ -1223,6 +1282,7 @@ bool CommandLineInterface::processInput()
 
 	vector<string> const exclusiveModes = {
 		g_argStandardJSON,
+		g_strServer,
 		g_argLink,
 		g_argAssemble,
 		g_argStrictAssembly,
@@ -1236,6 +1296,47 @@ bool CommandLineInterface::processInput()
 		return false;
 	}
 
+	if (m_args.count(g_strCacheDir) && !m_args.count(g_argStandardJSON) && !m_args.count(g_strServer))
+	{
+		serr() << "Option --" << g_strCacheDir << " is only valid in --" << g_argStandardJSON << " and --" << g_strServer << " mode." << endl;
+		return false;
+	}
+
+	if (m_args.count(g_argModelCheckerCacheDir) && (m_args.count(g_argStandardJSON) || m_args.count(g_strServer)))
+	{
+		serr() << "Option --" << g_argModelCheckerCacheDir << " is not valid in --" << g_argStandardJSON << " and --" << g_strServer << " mode. ";
+		serr() << "Use --" << g_strCacheDir << " instead, which also stores the answers of the solvers." << endl;
+		return false;
+	}
+
+	if (m_args.count(g_strServer))
+	{
+		if (m_args.count(g_argInputFile))
+		{
+			serr() << "If --" << g_strServer << " is used, no input files are supported." << endl;
+			return false;
+		}
+
+		// Each request creates its strings in a repository of its own, which is released
+		// afterwards. The dialects and the Ewasm polyfill are kept in the global repository
+		// and stay warm for the whole session.
+		StandardCompiler compiler(m_fileReader.reader());
+		if (m_args.count(g_strCacheDir))
+			compiler.enableCompilationCache(m_args[g_strCacheDir].as<string>());
+
+		string request;
+		while (getline(cin, request))
+		{
+			if (request.find_first_not_of(" \t\r") == string::npos)
+				continue;
+			compiler.compile(request, sout());
+			sout() << endl;
+			// Do not keep the contents of imported files around between requests.
+			m_fileReader.setSources({});
+		}
+		return true;
+	}
+
 	if (m_args.count(g_argStandardJSON))
 	{
 		vector<string> inputFiles;
@@ -1265,7 +1366,10 @@ bool CommandLineInterface::processInput()
 			}
 		}
 		StandardCompiler compiler(m_fileReader.reader());
-		sout() << compiler.compile(std::move(input)) << endl;
+		if (m_args.count(g_strCacheDir))
+			compiler.enableCompilationCache(m_args[g_strCacheDir].as<string>());
+		compiler.compile(input, sout());
+		sout() << endl;
 		return true;
 	}
 
@@ -1469,6 +1573,16 @@ bool CommandLineInterface::processInput()
 	if (m_args.count(g_argModelCheckerTimeout))
 		m_modelCheckerSettings.timeout = m_args[g_argModelCheckerTimeout].as<unsigned>();
 
+	if (m_args[g_argModelCheckerJobs].as<unsigned>() == 0)
+	{
+		serr() << "--" << g_argModelCheckerJobs << " must be at least 1." << endl;
+		return false;
+	}
+	m_modelCheckerSettings.jobs = m_args[g_argModelCheckerJobs].as<unsigned>();
+
+	if (m_args.count(g_argModelCheckerCacheDir))
+		m_modelCheckerSettings.cacheDirectory = m_args[g_argModelCheckerCacheDir].as<string>();
+
 	m_compiler = make_unique<CompilerStack>(m_fileReader.reader());
 
 	SourceReferenceFormatter formatter(serr(false), m_coloredOutput, m_withErrorIds);
@@ -1483,7 +1597,9 @@ bool CommandLineInterface::processInput()
 			m_args.count(g_argModelCheckerContracts) ||
 			m_args.count(g_argModelCheckerEngine) ||
 			m_args.count(g_argModelCheckerTargets) ||
-			m_args.count(g_argModelCheckerTimeout)
+			m_args.count(g_argModelCheckerTimeout) ||
+			m_args.count(g_argModelCheckerCacheDir) ||
+			m_modelCheckerSettings.jobs > 1
 		)
 			m_compiler->setModelCheckerSettings(m_modelCheckerSettings);
 		if (m_args.count(g_argInputFile))
@@ -1525,7 +1641,10 @@ bool CommandLineInterface::processInput()
 			settings.yulOptimiserSteps = m_args[g_strYulOptimizations].as<string>();
 		}
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
+		settings.yulOptimiserThreads = m_args[g_strYulOptimizerThreads].as<unsigned>();
+		settings.opcodeOptimiserThreads = m_args[g_strOpcodeOptimizerThreads].as<unsigned>();
 		m_compiler->setOptimiserSettings(settings);
+		m_compiler->setCompilerThreads(m_args[g_strJobs].as<unsigned>());
 
 		if (m_args.count(g_argImportAst))
 		{
@@ -1551,6 +1670,7 @@ bool CommandLineInterface::processInput()
 			m_compiler->setSources(m_fileReader.sourceCodes());
 			if (m_args.count(g_argErrorRecovery))
 				m_compiler->setParserErrorRecovery(true);
+			m_compiler->setParserThreads(m_args[g_strParserThreads].as<unsigned>());
 		}
 
 		bool successful = m_compiler->compile(m_stopAfter);
@@ -1703,6 +1823,13 @@ void CommandLineInterface::handleCombinedJSON()
 			output[g_strSourceList].append(source);
 	}
 
+	// Compact output to stdout writes the ASTs one contract member at a time
+	// instead of building the whole output in memory.
+	bool const streamASTs =
+		requests.count(g_strAst) &&
+		!m_args.count(g_argPrettyJson) &&
+		!m_args.count(g_argOutputDir);
+
 	if (requests.count(g_strAst))
 	{
 		output[g_strSources] = Json::Value(Json::objectValue);
@@ -1710,8 +1837,38 @@ void CommandLineInterface::handleCombinedJSON()
 		{
 			ASTJsonConverter converter(m_compiler->state(), m_compiler->sourceIndices());
 			output[g_strSources][sourceCode.first] = Json::Value(Json::objectValue);
-			output[g_strSources][sourceCode.first]["AST"] = converter.toJson(m_compiler->ast(sourceCode.first));
+			if (!streamASTs)
+				output[g_strSources][sourceCode.first]["AST"] = converter.toJson(m_compiler->ast(sourceCode.first));
+		}
+	}
+
+	if (streamASTs)
+	{
+		output = removeNullMembers(std::move(output));
+		JsonCompactStreamWriter writer(sout());
+		writer.beginObject();
+		for (string const& name: output.getMemberNames())
+		{
+			writer.key(name);
+			if (name != g_strSources)
+			{
+				writer.value(output[name]);
+				continue;
+			}
+			writer.beginObject();
+			for (auto const& sourceCode: m_fileReader.sourceCodes())
+			{
+				writer.key(sourceCode.first);
+				writer.beginObject();
+				writer.key("AST");
+				ASTJsonConverter(m_compiler->state(), m_compiler->sourceIndices()).write(writer, m_compiler->ast(sourceCode.first));
+				writer.endObject();
+			}
+			writer.endObject();
 		}
+		writer.endObject();
+		sout() << endl;
+		return;
 	}
 
 	string json = m_args.count(g_argPrettyJson) ? jsonPrettyPrint(removeNullMembers(std::move(output))) :
@@ -1757,7 +1914,7 @@ void CommandLineInterface::handleAst()
 
 bool CommandLineInterface::actOnInput()
 {
-	if (m_args.count(g_argStandardJSON) || m_onlyAssemble)
+	if (m_args.count(g_argStandardJSON) || m_args.count(g_strServer) || m_onlyAssemble)
 		// Already done in "processInput" phase.
 		return true;
 	else if (m_onlyLink)
@@ -1881,6 +2038,7 @@ bool CommandLineInterface::assemble(
 		OptimiserSettings settings = _optimize ? OptimiserSettings::full() : OptimiserSettings::minimal();
 		if (_yulOptimiserSteps.has_value())
 			settings.yulOptimiserSteps = _yulOptimiserSteps.value();
+		settings.yulOptimiserThreads = m_args[g_strYulOptimizerThreads].as<unsigned>();
 
 		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(m_evmVersion, _language, settings);
 		try
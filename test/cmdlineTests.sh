@@ -139,7 +139,7 @@ function test_solc_behaviour()
     exitCode=$?
     set -e
 
-    if [[ " ${solc_args[*]} " == *" --standard-json "* ]]
+    if [[ " ${solc_args[*]} " == *" --standard-json "* || " ${solc_args[*]} " == *" --server "* ]]
     then
         sed -i.bak -e 's/{[^{]*Warning: This is a pre-release compiler version[^}]*},\{0,1\}//' "$stdout_path"
         sed -i.bak -E -e 's/ Consider adding \\"pragma solidity \^[0-9.]*;\\"//g' "$stdout_path"
@@ -433,6 +433,27 @@ SOLTMPDIR=$(mktemp -d)
 )
 rm -rf "$SOLTMPDIR"
 
+printTask "Testing the model checker cache..."
+SOLTMPDIR=$(mktemp -d)
+(
+    set -e
+    contract='contract C { function f(uint x) public pure { assert(x > 0); } }'
+    cacheDir="$SOLTMPDIR/smt"
+    uncached=$(echo "$contract" | "$SOLC" - --model-checker-engine bmc 2>&1)
+    # Answers are stored on the first run and the output does not change.
+    [[ $(echo "$contract" | "$SOLC" - --model-checker-engine bmc --model-checker-cache-dir "$cacheDir" 2>&1) == "$uncached" ]]
+    [[ $(echo "$contract" | "$SOLC" - --model-checker-engine bmc --model-checker-cache-dir "$cacheDir" 2>&1) == "$uncached" ]]
+    if [[ "$uncached" =~ "Assertion violation happens here" ]]
+    then
+        # The second run takes the answers from the cache: a counterexample turned into
+        # a proof in the cache makes the violation disappear.
+        [[ -n $(ls -A "$cacheDir") ]]
+        sed -i -e 's/"result":"sat"/"result":"unsat"/' "$cacheDir"/*.json
+        [[ ! $(echo "$contract" | "$SOLC" - --model-checker-engine bmc --model-checker-cache-dir "$cacheDir" 2>&1) =~ "Assertion violation happens here" ]]
+    fi
+)
+rm -rf "$SOLTMPDIR"
+
 printTask "Testing assemble, yul, strict-assembly and optimize..."
 (
     echo '{}' | "$SOLC" - --assemble &>/dev/null
@@ -0,0 +1,8 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+
+import "./c.sol";
+
+contract A is C {
+	function f() public pure returns (uint) { return 1; }
+}
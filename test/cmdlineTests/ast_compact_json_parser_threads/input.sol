@@ -0,0 +1,7 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+
+import "./a.sol";
+import "./b.sol";
+
+contract D is A, B {}
@@ -0,0 +1,15 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+
+contract A {
+    uint public x;
+    function f(uint y) public { x = y * 2; }
+}
+contract B {
+    A a = new A();
+    function g() public returns (A) { return new A(); }
+}
+contract C {
+    B b = new B();
+    A a = new A();
+}
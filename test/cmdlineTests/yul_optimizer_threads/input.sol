@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+pragma abicoder v2;
+
+// The point of this test is to check that
+// optimizing functions in parallel produces
+// the same output as the name_simplifier test.
+
+struct S { uint x; }
+struct T { uint[2] y; }
+
+contract C {
+	S[2] values;
+	T t;
+
+	function sumArray(S[] memory _s) public returns (uint, string memory) {
+		values[0].x = _s[0].x;
+		t.y[0] = _s[1].x;
+		return (t.y[0], "longstringlongstringlongstringlongstringlongstringlongstringlongstringlongstringlongstringlongstring");
+	}
+}
@@ -975,6 +975,49 @@ BOOST_AUTO_TEST_CASE(block_deduplicator_loops)
 	BOOST_CHECK_EQUAL(pushTags.size(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(block_deduplicator_cascade)
+{
+	// Blocks 2 and 1 only become equal after 4 has been replaced by 3.
+	AssemblyItems input{
+		AssemblyItem(PushTag, 1),
+		AssemblyItem(PushTag, 2),
+		AssemblyItem(PushTag, 5),
+		Instruction::JUMPI,
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(1),
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		u256(1),
+		AssemblyItem(PushTag, 4),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 3),
+		u256(0),
+		Instruction::DUP1,
+		Instruction::REVERT,
+		AssemblyItem(Tag, 4),
+		u256(0),
+		Instruction::DUP1,
+		Instruction::REVERT,
+		AssemblyItem(Tag, 5),
+		u256(0),
+		Instruction::DUP1,
+		AssemblyItem(Tag, 6),
+		Instruction::REVERT
+	};
+	BlockDeduplicator deduplicator(input);
+	BOOST_CHECK(deduplicator.deduplicate());
+
+	map<u256, u256> expectation{{2, 1}, {4, 3}, {5, 3}};
+	BOOST_CHECK(deduplicator.replacedTags() == expectation);
+	set<u256> pushTags;
+	for (AssemblyItem const& item: input)
+		if (item.type() == PushTag)
+			pushTags.insert(item.data());
+	BOOST_CHECK(pushTags == set<u256>({1, 3}));
+}
+
 BOOST_AUTO_TEST_CASE(clear_unreachable_code)
 {
 	AssemblyItems items{
@@ -1049,6 +1092,64 @@ BOOST_AUTO_TEST_CASE(peephole_pop_calldatasize)
 	BOOST_CHECK(items.empty());
 }
 
+BOOST_AUTO_TEST_CASE(peephole_unchanged_prefix)
+{
+	AssemblyItems items{
+		u256(1),
+		u256(2),
+		Instruction::SSTORE,
+		u256(4),
+		Instruction::CALLDATASIZE,
+		Instruction::LT,
+		Instruction::POP
+	};
+	AssemblyItems expectation{
+		u256(1),
+		u256(2),
+		Instruction::SSTORE
+	};
+	PeepholeOptimiser peepOpt(items);
+	for (size_t i = 0; i < 3; i++)
+		BOOST_CHECK(peepOpt.optimise());
+	BOOST_CHECK(!peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(peephole_unchanged_prefix_boundary)
+{
+	// The first round removes PUSH POP, which completes a pattern that starts
+	// three items earlier, at the first item the second round looks at again.
+	AssemblyItems items{
+		u256(1),
+		u256(2),
+		Instruction::SSTORE,
+		Instruction::ISZERO,
+		Instruction::ISZERO,
+		AssemblyItem(PushTag, 1),
+		u256(5),
+		Instruction::POP,
+		Instruction::JUMPI
+	};
+	AssemblyItems expectation{
+		u256(1),
+		u256(2),
+		Instruction::SSTORE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI
+	};
+	PeepholeOptimiser peepOpt(items);
+	for (size_t i = 0; i < 2; i++)
+		BOOST_CHECK(peepOpt.optimise());
+	BOOST_CHECK(!peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
 BOOST_AUTO_TEST_CASE(peephole_commutative_swap1)
 {
 	vector<Instruction> ops{
@@ -1309,6 +1410,77 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(parallel_subassemblies)
+{
+	// This tests that optimising sub-assemblies concurrently gives the same
+	// assembly as optimising them one after the other, also for nested
+	// sub-assemblies (which are optimised serially inside their thread)
+	// and tag unifications visible at the super-assembly.
+
+	// Creates a sub-assembly with two identical blocks, referenced from the super-assembly.
+	auto makeLeaf = [](u256 const& _value) {
+		AssemblyPointer leaf = make_shared<Assembly>();
+		leaf->append(_value);
+		auto t1 = leaf->newTag();
+		leaf->append(t1);
+		leaf->append(u256(2));
+		leaf->append(Instruction::JUMP);
+		auto t2 = leaf->newTag();
+		leaf->append(t2);
+		leaf->append(u256(2));
+		leaf->append(Instruction::JUMP);
+		leaf->append(u256(0));
+		leaf->append(t2.pushTag());
+		leaf->append(Instruction::JUMPI);
+		leaf->append(Instruction::STOP);
+		return make_pair(leaf, vector<AssemblyItem>{t1, t2});
+	};
+	// Creates an assembly that creates the given sub-assemblies and jumps into their tags.
+	auto makeFactory = [](vector<pair<AssemblyPointer, vector<AssemblyItem>>> const& _subs) {
+		AssemblyPointer factory = make_shared<Assembly>();
+		for (auto const& [sub, tags]: _subs)
+		{
+			size_t subId = static_cast<size_t>(factory->appendSubroutine(sub).data());
+			factory->pushSubroutineOffset(subId);
+			for (AssemblyItem const& tag: tags)
+				factory->append(tag.toSubAssemblyTag(subId).pushTag());
+			factory->append(u256(0));
+			factory->append(Instruction::DUP1);
+			factory->append(Instruction::ADD);
+			factory->append(Instruction::POP);
+		}
+		factory->append(Instruction::STOP);
+		return factory;
+	};
+	auto makeMain = [&]() {
+		AssemblyPointer nested = makeFactory({makeLeaf(5), makeLeaf(6)});
+		return makeFactory({makeLeaf(1), {nested, {}}, makeLeaf(2), makeLeaf(3)});
+	};
+
+	Assembly::OptimiserSettings settings;
+	settings.isCreation = true;
+	settings.runInliner = true;
+	settings.runJumpdestRemover = true;
+	settings.runPeephole = true;
+	settings.runDeduplicate = true;
+	settings.runCSE = true;
+	settings.runConstantOptimiser = true;
+	settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	settings.expectedExecutionsPerDeployment = 200;
+
+	settings.threads = 1;
+	AssemblyPointer serial = makeMain();
+	serial->optimise(settings);
+	for (size_t threads: vector<size_t>{2, 4, 16})
+	{
+		settings.threads = threads;
+		AssemblyPointer parallel = makeMain();
+		parallel->optimise(settings);
+		BOOST_CHECK_EQUAL(parallel->assemblyString(), serial->assemblyString());
+		BOOST_CHECK_EQUAL(parallel->assemble().toHex(), serial->assemble().toHex());
+	}
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
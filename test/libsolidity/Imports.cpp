@@ -25,9 +25,12 @@
 #include <test/Common.h>
 
 #include <liblangutil/Exceptions.h>
+#include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/ImportRemapper.h>
 
+#include <libsolutil/JSON.h>
+
 #include <boost/test/unit_test.hpp>
 
 #include <string>
@@ -113,6 +116,132 @@ BOOST_AUTO_TEST_CASE(context_dependent_remappings_order_independent_2)
 	BOOST_CHECK(c.compile());
 }
 
+BOOST_AUTO_TEST_CASE(replace_source)
+{
+	size_t callbackCalls = 0;
+	CompilerStack c([&](string const&, string const& _path) -> ReadCallback::Result {
+		++callbackCalls;
+		if (_path == "lib.sol")
+			return {true, "contract L { function f() public pure returns (uint) { return 1; } } pragma solidity >=0.0;"};
+		return {false, "not found"};
+	});
+	c.setSources({{"main.sol", "import \"lib.sol\"; contract Main is L {} pragma solidity >=0.0;"}});
+	c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK_EQUAL(callbackCalls, 1);
+
+	c.replaceSource("main.sol", "import \"lib.sol\"; contract Main is L { uint x = f() } pragma solidity >=0.0;");
+	BOOST_CHECK(c.state() == CompilerStack::SourcesSet);
+	BOOST_CHECK(!c.compile());
+	BOOST_CHECK(!langutil::Error::containsOnlyWarnings(c.errors()));
+
+	c.replaceSource("main.sol", "import \"lib.sol\"; contract Main is L { uint x = f(); } pragma solidity >=0.0;");
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK(c.contractNames() == (vector<string>{"lib.sol:L", "main.sol:Main"}));
+	// lib.sol was kept and not requested again.
+	BOOST_CHECK_EQUAL(callbackCalls, 1);
+}
+
+BOOST_AUTO_TEST_CASE(replace_source_drops_import)
+{
+	size_t callbackCalls = 0;
+	CompilerStack c([&](string const&, string const& _path) -> ReadCallback::Result {
+		++callbackCalls;
+		if (_path == "lib.sol")
+			return {true, "contract L {} pragma solidity >=0.0;"};
+		return {false, "not found"};
+	});
+	c.setSources({{"main.sol", "import \"lib.sol\"; contract Main is L {} pragma solidity >=0.0;"}});
+	c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK(c.sourceNames() == (vector<string>{"lib.sol", "main.sol"}));
+
+	// lib.sol is not imported any more and thus not compiled or part of the metadata.
+	c.replaceSource("main.sol", "contract Main {} pragma solidity >=0.0;");
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK(c.sourceNames() == (vector<string>{"main.sol"}));
+	BOOST_CHECK(c.contractNames() == (vector<string>{"main.sol:Main"}));
+	BOOST_CHECK(c.metadata("Main").find("lib.sol") == string::npos);
+
+	// Importing it again uses the content loaded before.
+	c.replaceSource("main.sol", "import \"lib.sol\"; contract Main is L {} pragma solidity >=0.0;");
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK(c.contractNames() == (vector<string>{"lib.sol:L", "main.sol:Main"}));
+	BOOST_CHECK_EQUAL(callbackCalls, 1);
+}
+
+BOOST_AUTO_TEST_CASE(replace_imported_source)
+{
+	size_t callbackCalls = 0;
+	string libContent = "contract L {} pragma solidity >=0.0;";
+	CompilerStack c([&](string const&, string const& _path) -> ReadCallback::Result {
+		++callbackCalls;
+		if (_path == "lib.sol")
+			return {true, libContent};
+		return {false, "not found"};
+	});
+	c.setSources({{"main.sol", "import \"lib.sol\"; contract Main is L {} pragma solidity >=0.0;"}});
+	c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(c.compile());
+
+	// Replacing an imported source changes its content, but it is still only compiled if it is imported.
+	c.replaceSource("lib.sol", "contract K {} contract L {} pragma solidity >=0.0;");
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK(c.contractNames() == (vector<string>{"lib.sol:K", "lib.sol:L", "main.sol:Main"}));
+	c.replaceSource("main.sol", "contract Main {} pragma solidity >=0.0;");
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK(c.sourceNames() == (vector<string>{"main.sol"}));
+	BOOST_CHECK_EQUAL(callbackCalls, 1);
+
+	// After invalidating it, the content is requested from the callback again.
+	libContent = "contract M {} pragma solidity >=0.0;";
+	c.replaceSource("main.sol", "import \"lib.sol\"; contract Main {} pragma solidity >=0.0;");
+	c.invalidateImportedSource("lib.sol");
+	BOOST_REQUIRE(c.compile());
+	BOOST_CHECK(c.contractNames() == (vector<string>{"lib.sol:M", "main.sol:Main"}));
+	BOOST_CHECK_EQUAL(callbackCalls, 2);
+
+	BOOST_CHECK_THROW(c.invalidateImportedSource("main.sol"), langutil::CompilerError);
+}
+
+BOOST_AUTO_TEST_CASE(parser_threads_discarded_lookahead_nodes)
+{
+	// Declarations like these create nodes during look-ahead that are discarded again.
+	// Parsing in parallel has to assign the same node IDs as a single parser.
+	string const lib = R"(
+		pragma solidity >=0.0;
+		library S { struct T { uint x; } }
+	)";
+	auto user = [](string const& _contractName) {
+		return R"(
+		pragma solidity >=0.0;
+		import "lib.sol";
+		contract )" + _contractName + R"( {
+			S.T[] t;
+			function f() public view returns (uint) {
+				uint[] memory x = new uint[](2);
+				S.T[] storage y = t;
+				uint[2][] memory z;
+				return x.length + y.length + z.length;
+			}
+		}
+		)";
+	};
+	auto astJson = [&](unsigned _threads) {
+		CompilerStack c;
+		c.setSources({{"a.sol", user("C")}, {"b.sol", "import \"a.sol\";" + user("D")}, {"lib.sol", lib}});
+		c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		c.setParserThreads(_threads);
+		BOOST_REQUIRE(c.parseAndAnalyze());
+		string result;
+		for (string const& source: c.sourceNames())
+			result += util::jsonCompactPrint(ASTJsonConverter(c.state(), c.sourceIndices()).toJson(c.ast(source)));
+		return result;
+	};
+	string const serial = astJson(1);
+	BOOST_CHECK_EQUAL(astJson(4), serial);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
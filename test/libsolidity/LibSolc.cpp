@@ -21,6 +21,7 @@
  */
 
 #include <string>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include <libsolutil/JSON.h>
 #include <libsolidity/interface/ReadFile.h>
@@ -179,6 +180,54 @@ BOOST_AUTO_TEST_CASE(with_callback)
 	BOOST_CHECK(containsError(result, "ParserError", "Source \"notfound.sol\" not found: Callback not supported."));
 }
 
+BOOST_AUTO_TEST_CASE(compiler_context)
+{
+	CStyleReadFileCallback callback{
+		[](void* _context, char const*, char const* _path, char** o_contents, char** o_error)
+		{
+			BOOST_REQUIRE(_context != nullptr);
+			*o_contents = stringToSolidity("contract " + string(_path).substr(0, 1) + " {}");
+			*o_error = nullptr;
+		}
+	};
+	int context = 0;
+
+	solidity_compiler* compiler = solidity_compiler_create(4);
+	BOOST_REQUIRE(compiler != nullptr);
+
+	vector<size_t> jobs;
+	vector<string> inputs;
+	for (size_t i = 0; i < 8; ++i)
+	{
+		inputs.emplace_back(R"({
+			"language": "Solidity",
+			"sources": { "fileA": { "content": "import \"B)" + to_string(i) + R"(.sol\"; contract A)" + to_string(i) + R"( {}" } },
+			"settings": { "outputSelection": { "*": { "*": [ "evm.bytecode.object" ] } } }
+		})");
+		jobs.push_back(solidity_compiler_submit(compiler, inputs.back().c_str(), callback, &context));
+		BOOST_REQUIRE(jobs.back() != 0);
+	}
+
+	for (size_t i = 0; i < jobs.size(); ++i)
+	{
+		char* output = solidity_compiler_wait(compiler, jobs[i]);
+		BOOST_REQUIRE(output != nullptr);
+		Json::Value result;
+		BOOST_REQUIRE(util::jsonParseStrict(output, result));
+		solidity_free(output);
+		BOOST_CHECK(result["contracts"]["fileA"]["A" + to_string(i)]["evm"]["bytecode"]["object"].isString());
+		BOOST_CHECK(result["contracts"]["B" + to_string(i) + ".sol"]["B"].isObject());
+
+		// Results are only handed out once.
+		BOOST_CHECK(solidity_compiler_poll(compiler, jobs[i]) == nullptr);
+		BOOST_CHECK(solidity_compiler_wait(compiler, jobs[i]) == nullptr);
+	}
+
+	solidity_compiler_submit(compiler, "{}", nullptr, nullptr);
+	solidity_compiler_destroy(compiler);
+	solidity_reset();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -22,15 +22,21 @@
 
 #include <string>
 #include <boost/test/unit_test.hpp>
+#include <boost/algorithm/string/replace.hpp>
+#include <libsolidity/formal/ModelChecker.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
 #include <test/Metadata.h>
+#include <test/TemporaryDirectory.h>
 
 #include <algorithm>
+#include <fstream>
 #include <set>
+#include <sstream>
 
 using namespace std;
 using namespace solidity::evmasm;
@@ -1795,6 +1801,198 @@ BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 	BOOST_REQUIRE(sourceMap.find(sourceRef) != string::npos);
 }
 
+BOOST_AUTO_TEST_CASE(compilation_cache)
+{
+	auto input = [](string const& _contentB) {
+		Json::Value parsedInput;
+		BOOST_REQUIRE(util::jsonParseStrict(R"(
+		{
+			"language": "Solidity",
+			"sources": {
+				"A.sol": { "content": "contract A { function f() public pure returns (uint) { return 1; } }" },
+				"B.sol": { "content": ""}
+			},
+			"settings": {
+				"outputSelection": { "*": { "*": ["abi", "evm.bytecode.object", "evm.deployedBytecode.sourceMap"] } }
+			}
+		}
+		)", parsedInput));
+		parsedInput["sources"]["B.sol"]["content"] = _contentB;
+		return parsedInput;
+	};
+	auto cacheEntries = [](boost::filesystem::path const& _directory) {
+		return distance(boost::filesystem::directory_iterator(_directory), boost::filesystem::directory_iterator());
+	};
+
+	solidity::test::TemporaryDirectory cacheDirectory;
+	Json::Value const uncached = compile(util::jsonCompactPrint(input("contract B { uint x; }")));
+	BOOST_REQUIRE(containsAtMostWarnings(uncached));
+
+	solidity::frontend::StandardCompiler compiler;
+	compiler.enableCompilationCache(cacheDirectory.path());
+	BOOST_CHECK_EQUAL(util::jsonCompactPrint(compiler.compile(input("contract B { uint x; }"))), util::jsonCompactPrint(uncached));
+	BOOST_CHECK_EQUAL(cacheEntries(cacheDirectory.path()), 2);
+
+	solidity::frontend::StandardCompiler otherCompiler;
+	otherCompiler.enableCompilationCache(cacheDirectory.path());
+	BOOST_CHECK_EQUAL(util::jsonCompactPrint(otherCompiler.compile(input("contract B { uint x; }"))), util::jsonCompactPrint(uncached));
+	BOOST_CHECK_EQUAL(cacheEntries(cacheDirectory.path()), 2);
+
+	// Only B has to be recompiled.
+	Json::Value changed = otherCompiler.compile(input("contract B { uint y; }"));
+	BOOST_CHECK_EQUAL(cacheEntries(cacheDirectory.path()), 3);
+	BOOST_CHECK_EQUAL(util::jsonCompactPrint(changed["contracts"]["A.sol"]), util::jsonCompactPrint(uncached["contracts"]["A.sol"]));
+	BOOST_CHECK_EQUAL(
+		util::jsonCompactPrint(changed["contracts"]["B.sol"]),
+		util::jsonCompactPrint(compile(util::jsonCompactPrint(input("contract B { uint y; }")))["contracts"]["B.sol"])
+	);
+
+	// Errors are reported on every compilation and nothing is stored.
+	Json::Value failed = otherCompiler.compile(input("contract B { uint y }"));
+	BOOST_CHECK(failed.isMember("errors"));
+	BOOST_CHECK(!failed.isMember("contracts"));
+	BOOST_CHECK_EQUAL(cacheEntries(cacheDirectory.path()), 3);
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_cache)
+{
+	string const input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": { "content": "contract C { function f(uint x) public pure { assert(x >= 0); assert(x > 0); } }" }
+		},
+		"settings": {
+			"modelChecker": { "engine": "bmc" }
+		}
+	}
+	)";
+
+	solidity::test::TemporaryDirectory cacheDirectory;
+	string const uncached = solidity::frontend::StandardCompiler{}.compile(input);
+
+	solidity::frontend::StandardCompiler compiler;
+	compiler.enableCompilationCache(cacheDirectory.path());
+	BOOST_CHECK_EQUAL(compiler.compile(input), uncached);
+	BOOST_CHECK_EQUAL(compiler.compile(input), uncached);
+	if (!ModelChecker::availableSolvers().some())
+		return;
+
+	boost::filesystem::path const smtDirectory = cacheDirectory.path() / "smt";
+	BOOST_REQUIRE(!boost::filesystem::is_empty(smtDirectory));
+	BOOST_REQUIRE(uncached.find("Assertion violation happens here") != string::npos);
+
+	// Turn every stored counterexample into a proof. If the answers are taken from the
+	// cache instead of the solver, the violation is not reported any more.
+	for (auto const& entry: boost::filesystem::directory_iterator(smtDirectory))
+	{
+		string content = solidity::util::readFileAsString(entry.path().string());
+		boost::replace_all(content, "\"result\":\"sat\"", "\"result\":\"unsat\"");
+		ofstream(entry.path().string(), ios::binary | ios::trunc) << content;
+	}
+	string const fromCache = compiler.compile(input);
+	BOOST_CHECK(fromCache.find("Assertion violation happens here") == string::npos);
+	BOOST_CHECK(fromCache != uncached);
+}
+
+BOOST_AUTO_TEST_CASE(parallelism)
+{
+	// B and C both create A, so the optimiser modifies the shared assembly of A
+	// for each of them, which has to happen in the same order as in the serial compilation.
+	string const sources = R"(
+		"A.sol": { "content": "pragma abicoder v1; contract A { uint public x; function f(uint y) public { x = y * 2; } }" },
+		"B.sol": { "content": "import \"A.sol\"; contract B { A a = new A(); function g() public returns (A) { return new A(); } }" },
+		"C.sol": { "content": "import \"B.sol\"; contract C { B b = new B(); A a = new A(); }" },
+		"D.sol": { "content": "import \"C.sol\"; contract D { function h() public returns (C) { return new C(); } }" }
+	)";
+	// The optimiser removes the assignment, so assembling fails with a code generation error.
+	string const failingSource = R"(
+		"E.sol": { "content": "contract E { uint immutable x; constructor() { x = 0; while (true) {} } function f() external view returns (uint) { return x; } }" }
+	)";
+	auto input = [](string const& _sources, bool _viaIR, unsigned _parallelism) {
+		return R"(
+		{
+			"language": "Solidity",
+			"sources": {)" + _sources + R"(},
+			"settings": {
+				"optimizer": { "enabled": true },
+				"viaIR": )" + (_viaIR ? "true" : "false") + R"(,
+				"parallelism": )" + to_string(_parallelism) + R"(,
+				"outputSelection": {
+					"*": { "*": [ "evm.assembly", "evm.bytecode.object", "evm.deployedBytecode.object", "irOptimized", "metadata" ] }
+				}
+			}
+		}
+		)";
+	};
+
+	solidity::frontend::StandardCompiler compiler;
+	for (bool viaIR: {false, true})
+	{
+		string const serial = compiler.compile(input(sources, viaIR, 1));
+		Json::Value serialResult;
+		BOOST_REQUIRE(util::jsonParseStrict(serial, serialResult));
+		BOOST_REQUIRE(containsAtMostWarnings(serialResult));
+		BOOST_CHECK_EQUAL(compiler.compile(input(sources, viaIR, 4)), serial);
+	}
+
+	// If anything fails, it is reported like in the serial compilation.
+	string const allSources = sources + "," + failingSource;
+	string const failed = compiler.compile(input(allSources, false, 1));
+	Json::Value failedResult;
+	BOOST_REQUIRE(util::jsonParseStrict(failed, failedResult));
+	BOOST_REQUIRE(containsError(failedResult, "CodeGenerationError", "Some immutables were read from but never assigned, possibly because of optimization."));
+	BOOST_CHECK_EQUAL(compiler.compile(input(allSources, false, 4)), failed);
+
+	Json::Value const invalid = compile(input(sources, false, 0));
+	BOOST_CHECK(containsError(invalid, "JSONError", "\"settings.parallelism\" must be a positive integer."));
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output)
+{
+	string const input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": { "content": "// SPDX-License-Identifier: GPL-3.0\ncontract A { struct S { uint x; } function f() public pure {} }" },
+			"B.sol": { "content": "import \"A.sol\"; contract B is A {} contract C {} enum E { X }" },
+			"C.sol": { "content": "contract D { function g() public { assembly {} } }" }
+		},
+		"settings": {
+			"outputSelection": { "*": { "*": [ "abi" ], "": [ "ast" ] } }
+		}
+	}
+	)";
+
+	solidity::frontend::StandardCompiler compiler;
+	string const expectation = compiler.compile(input);
+	BOOST_REQUIRE(compile(input)["sources"]["A.sol"].isMember("ast"));
+
+	ostringstream output;
+	compiler.compile(input, output);
+	BOOST_CHECK_EQUAL(output.str(), expectation);
+
+	// Errors before anything is written are reported as usual.
+	ostringstream invalidOutput;
+	compiler.compile("{", invalidOutput);
+	BOOST_CHECK_EQUAL(invalidOutput.str(), compiler.compile(string("{")));
+
+	string const failingInput = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": { "content": "contract A { function f() public { x = 1; } }" }
+		},
+		"settings": {
+			"outputSelection": { "*": { "": [ "ast" ] } }
+		}
+	}
+	)";
+	ostringstream failingOutput;
+	compiler.compile(failingInput, failingOutput);
+	BOOST_CHECK_EQUAL(failingOutput.str(), compiler.compile(failingInput));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
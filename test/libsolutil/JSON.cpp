@@ -21,11 +21,14 @@
  */
 
 #include <libsolutil/JSON.h>
+#include <libsolutil/Exceptions.h>
 
 #include <test/Common.h>
 
 #include <boost/test/unit_test.hpp>
 
+#include <sstream>
+
 using namespace std;
 
 namespace solidity::util::test
@@ -70,6 +73,49 @@ BOOST_AUTO_TEST_CASE(json_compact_print)
 	BOOST_CHECK("{\"1\":1,\"2\":\"2\",\"3\":{\"3.1\":\"3.1\",\"3.2\":2}}" == jsonCompactPrint(json));
 }
 
+BOOST_AUTO_TEST_CASE(json_compact_stream_writer)
+{
+	Json::Value json;
+	json["1"] = Json::arrayValue;
+	json["1"].append(1);
+	json["1"].append("x\"\xc3\xa4");
+	json["1"].append(Json::objectValue);
+	json["2"]["3.1"] = Json::arrayValue;
+	json["2"]["3.2"] = Json::nullValue;
+	json["\n"] = 2;
+
+	ostringstream output;
+	JsonCompactStreamWriter writer(output);
+	BOOST_CHECK(!writer.started());
+	writer.beginObject();
+	writer.key("\n");
+	writer.value(2);
+	writer.key("1");
+	writer.beginArray();
+	writer.value(1);
+	writer.value("x\"\xc3\xa4");
+	writer.beginObject();
+	writer.endObject();
+	writer.endArray();
+	writer.key("2");
+	writer.serializedValue(jsonCompactPrint(json["2"]));
+	writer.endObject();
+	BOOST_CHECK(writer.started());
+
+	BOOST_CHECK_EQUAL(output.str(), jsonCompactPrint(json));
+	BOOST_CHECK_THROW(writer.value(1), Exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_compact_stream_writer_member_order)
+{
+	ostringstream output;
+	JsonCompactStreamWriter writer(output);
+	writer.beginObject();
+	writer.key("b");
+	writer.value(1);
+	BOOST_CHECK_THROW(writer.key("a"), Exception);
+}
+
 BOOST_AUTO_TEST_CASE(parse_json_strict)
 {
 	Json::Value json;
@@ -0,0 +1,91 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the thread pool.
+ */
+
+#include <libsolutil/ThreadPool.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(runs_every_task_once)
+{
+	ThreadPool pool(4);
+	BOOST_CHECK_EQUAL(pool.threads(), 4);
+	// The same threads are reused for every batch, including empty ones.
+	for (size_t count: {0u, 1u, 3u, 1000u})
+	{
+		vector<atomic<unsigned>> calls(count);
+		pool.run(count, [&](size_t _index) { ++calls[_index]; });
+		for (auto const& call: calls)
+			BOOST_CHECK_EQUAL(call.load(), 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(single_thread)
+{
+	ThreadPool pool(1);
+	BOOST_CHECK_EQUAL(pool.threads(), 1);
+	vector<size_t> order;
+	pool.run(5, [&](size_t _index) { order.push_back(_index); });
+	BOOST_CHECK((order == vector<size_t>{0, 1, 2, 3, 4}));
+}
+
+BOOST_AUTO_TEST_CASE(rethrows_exception_of_first_task)
+{
+	ThreadPool pool(3);
+	atomic<size_t> calls{0};
+	auto task = [&](size_t _index) {
+		++calls;
+		if (_index % 10 == 7)
+			throw runtime_error(to_string(_index));
+	};
+	for (size_t round = 0; round < 3; ++round)
+	{
+		calls = 0;
+		try
+		{
+			pool.run(100, task);
+			BOOST_FAIL("Exception expected.");
+		}
+		catch (runtime_error const& _exception)
+		{
+			BOOST_CHECK_EQUAL(string(_exception.what()), "7");
+		}
+		// The remaining tasks still run.
+		BOOST_CHECK_EQUAL(calls.load(), 100);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -85,6 +85,23 @@ BOOST_AUTO_TEST_CASE(conditional_with_else)
 	BOOST_CHECK_EQUAL(Whiskers(templ)("b", false).render(), "Y");
 }
 
+BOOST_AUTO_TEST_CASE(conditional_with_repeated_else)
+{
+	string templ = "<?b>X<!b>Y<!b>Z</b>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("b", true).render(), "X");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("b", false).render(), "Y<!b>Z");
+}
+
+BOOST_AUTO_TEST_CASE(template_reuse)
+{
+	string templ = "<a><?c>-<b><!c>+</c>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "A")("b", "B")("c", true).render(), "A-B");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "1")("b", "2")("c", false).render(), "1+");
+	Whiskers m(templ);
+	m("a", "A")("c", true);
+	BOOST_CHECK_THROW(m.render(), WhiskersError);
+}
+
 BOOST_AUTO_TEST_CASE(conditional_plus_params)
 {
 	string templ = " - <?b>_<r><!b>^<t></b> - ";
@@ -0,0 +1,110 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for running the optimiser suite on several threads.
+ */
+
+#include <test/Common.h>
+#include <test/libyul/Common.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libyul/optimiser/Suite.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AST.h>
+#include <libyul/Object.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+/// @returns code with @a _functions functions that call each other in a cycle, so that
+/// they are not inlined, and that contain work for the common subexpression eliminator,
+/// the load resolver and the function-local steps.
+string manyFunctions(size_t _functions)
+{
+	string code = "{\n";
+	code += "\tsstore(0, f0(calldataload(0), calldataload(32)))\n";
+	for (size_t i = 0; i < _functions; ++i)
+	{
+		string const next = "f" + to_string((i + 1) % _functions);
+		string const offset = to_string(i * 32);
+		code +=
+			"\tfunction f" + to_string(i) + "(a, b) -> r {\n"
+			"\t\tlet x := add(a, mload(" + offset + "))\n"
+			"\t\tsstore(a, x)\n"
+			"\t\tlet y := add(a, mload(" + offset + "))\n"
+			"\t\tr := add(sload(a), y)\n"
+			"\t\tif iszero(iszero(gt(b, " + offset + "))) { r := add(r, " + next + "(sub(b, 1), y)) }\n"
+			"\t\tfor { let i := 0 } lt(i, b) { i := add(i, 1) } { mstore(add(i, " + offset + "), keccak256(0, 32)) }\n"
+			"\t}\n";
+	}
+	return code + "}\n";
+}
+
+string optimise(string const& _source, size_t _threads)
+{
+	EVMDialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(solidity::test::CommonOptions::get().evmVersion());
+	ErrorList errors;
+	auto [object, analysisInfo] = parse(_source, dialect, errors);
+	BOOST_REQUIRE(object && errors.empty());
+	object->analysisInfo = analysisInfo;
+
+	GasMeter meter(dialect, false, 200);
+	OptimiserSuite::run(
+		dialect,
+		&meter,
+		*object,
+		true,
+		frontend::OptimiserSettings::DefaultYulOptimiserSteps,
+		200,
+		{},
+		_threads
+	);
+	return AsmPrinter{}(*object->code);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulOptimiserSuite)
+
+BOOST_AUTO_TEST_CASE(threads_do_not_change_output)
+{
+	string const source = manyFunctions(40);
+	string const expectation = optimise(source, 1);
+	// The functions have to survive inlining for the test to be meaningful.
+	BOOST_REQUIRE(expectation.find("function ") != expectation.rfind("function "));
+
+	for (size_t threads: {2u, 3u, 8u})
+		BOOST_CHECK_EQUAL(optimise(source, threads), expectation);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
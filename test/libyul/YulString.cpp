@@ -0,0 +1,130 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+	YulString s;
+	BOOST_CHECK(s.empty());
+	BOOST_CHECK_EQUAL(s.str(), "");
+	BOOST_CHECK(YulString("") == s);
+	BOOST_CHECK_EQUAL(s.hash(), YulStringRepository::emptyHash());
+	BOOST_CHECK(!YulString("x").empty());
+}
+
+BOOST_AUTO_TEST_CASE(identity)
+{
+	YulString a("abc");
+	YulString b(string("ab") + "c");
+	YulString c("abd");
+	BOOST_CHECK(a == b);
+	BOOST_CHECK(a != c);
+	BOOST_CHECK(!(a < b) && !(b < a));
+	BOOST_CHECK((a < c) != (c < a));
+	BOOST_CHECK_EQUAL(a.str(), "abc");
+	BOOST_CHECK_EQUAL(&a.str(), &b.str());
+	BOOST_CHECK_EQUAL(c.str(), "abd");
+}
+
+BOOST_AUTO_TEST_CASE(scopes)
+{
+	YulString global("in_global_repository");
+	weak_ptr<YulStringRepository> released;
+	{
+		YulStringRepository::Scope scope;
+		BOOST_CHECK(scope.repository() != YulStringRepository::global());
+		BOOST_CHECK(&YulStringRepository::instance() == scope.repository().get());
+		released = scope.repository();
+
+		// Strings of the global repository are not added again.
+		BOOST_CHECK_EQUAL(&YulString("in_global_repository").str(), &global.str());
+		YulString a("in_scope");
+		{
+			YulStringRepository::Scope nested;
+			BOOST_CHECK(nested.repository() == scope.repository());
+			BOOST_CHECK_EQUAL(&YulString("in_scope").str(), &a.str());
+		}
+
+		YulString b;
+		thread([&]() {
+			YulStringRepository::Scope other{scope.repository()};
+			b = YulString("in_scope");
+		}).join();
+		BOOST_CHECK_EQUAL(&b.str(), &a.str());
+
+		// Strings of different repositories still compare equal.
+		shared_ptr<YulStringRepository> otherRepository = YulStringRepository::create();
+		YulString c;
+		{
+			YulStringRepository::Scope other{otherRepository};
+			c = YulString("in_scope");
+		}
+		BOOST_CHECK(&c.str() != &a.str());
+		BOOST_CHECK(c == a);
+		BOOST_CHECK(!(c != a));
+		BOOST_CHECK(!(c < a) && !(a < c));
+		BOOST_CHECK(c != YulString("in_scope_"));
+	}
+	BOOST_CHECK(released.expired());
+	BOOST_CHECK(&YulStringRepository::instance() == YulStringRepository::global().get());
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	size_t const threadCount = 8;
+	size_t const stringCount = 2000;
+
+	vector<vector<YulString>> results(threadCount);
+	vector<thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+		threads.emplace_back([&, t]() {
+			for (size_t i = 0; i < stringCount; ++i)
+				results[t].emplace_back("concurrent_" + to_string((i + t * 7) % stringCount));
+		});
+	for (auto& thread: threads)
+		thread.join();
+
+	for (size_t t = 0; t < threadCount; ++t)
+		for (size_t i = 0; i < stringCount; ++i)
+		{
+			YulString const& s = results[t][i];
+			BOOST_REQUIRE_EQUAL(s.str(), "concurrent_" + to_string((i + t * 7) % stringCount));
+			BOOST_REQUIRE(s == YulString(s.str()));
+			BOOST_REQUIRE(s == results[0][(i + t * 7) % stringCount]);
+		}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -35,6 +35,7 @@
 #include <libsolutil/FixedHash.h>
 
 #include <boost/algorithm/cxx11/all_of.hpp>
+#include <boost/functional/hash.hpp>
 
 #include <range/v3/view/reverse.hpp>
 
@@ -48,11 +49,99 @@ using namespace solidity::yul::test;
 
 using solidity::util::h256;
 
+uint8_t InterpreterMemory::get(u256 const& _offset) const
+{
+	if (_offset < ContiguousLimit)
+	{
+		size_t offset = size_t(_offset);
+		return offset < m_contiguous.size() ? m_contiguous[offset] : 0;
+	}
+	auto it = m_sparse.find(_offset);
+	return it == m_sparse.end() ? 0 : it->second;
+}
+
+void InterpreterMemory::set(u256 const& _offset, uint8_t _value)
+{
+	if (_offset < ContiguousLimit)
+	{
+		size_t offset = size_t(_offset);
+		if (offset >= m_contiguous.size())
+		{
+			if (_value == 0)
+				return;
+			m_contiguous.resize(offset + 1);
+		}
+		m_contiguous[offset] = _value;
+	}
+	else
+		m_sparse[_offset] = _value;
+}
+
+bytes InterpreterMemory::read(u256 const& _offset, size_t _size) const
+{
+	bytes data(_size, 0);
+	if (_offset < ContiguousLimit && _size <= ContiguousLimit - size_t(_offset))
+	{
+		size_t offset = size_t(_offset);
+		if (offset < m_contiguous.size())
+		{
+			size_t available = min(_size, m_contiguous.size() - offset);
+			copy_n(m_contiguous.begin() + static_cast<ptrdiff_t>(offset), available, data.begin());
+		}
+	}
+	else
+		for (size_t i = 0; i < _size; ++i)
+			data[i] = get(_offset + i);
+	return data;
+}
+
+void InterpreterMemory::write(u256 const& _offset, uint8_t const* _data, size_t _size)
+{
+	if (_offset < ContiguousLimit && _size <= ContiguousLimit - size_t(_offset))
+	{
+		size_t offset = size_t(_offset);
+		if (offset + _size > m_contiguous.size())
+			m_contiguous.resize(offset + _size);
+		copy_n(_data, _size, m_contiguous.begin() + static_cast<ptrdiff_t>(offset));
+	}
+	else
+		for (size_t i = 0; i < _size; ++i)
+			set(_offset + i, _data[i]);
+}
+
+map<u256, u256> InterpreterMemory::nonZeroWords() const
+{
+	map<u256, u256> words;
+	for (size_t offset = 0; offset < m_contiguous.size(); offset += 0x20)
+	{
+		u256 word;
+		for (size_t i = 0; i < 0x20; ++i)
+			word = (word << 8) | (offset + i < m_contiguous.size() ? m_contiguous[offset + i] : 0);
+		if (word != 0)
+			words[offset] = word;
+	}
+	map<u256, u256> sparseWords;
+	for (auto const& [offset, value]: m_sparse)
+		sparseWords[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * static_cast<size_t>(offset % 0x20));
+	for (auto const& [offset, value]: sparseWords)
+		if (value != 0)
+			words[offset] = value;
+	return words;
+}
+
+size_t H256Hash::operator()(h256 const& _value) const
+{
+	return boost::hash_range(_value.data(), _value.data() + h256::size);
+}
+
 void InterpreterState::dumpStorage(ostream& _out) const
 {
-	for (auto const& slot: storage)
-		if (slot.second != h256{})
-			_out << "  " << slot.first.hex() << ": " << slot.second.hex() << endl;
+	map<h256, h256> sortedStorage;
+	for (auto const& [slot, value]: storage)
+		if (value != h256{})
+			sortedStorage.emplace(slot, value);
+	for (auto const& [slot, value]: sortedStorage)
+		_out << "  " << slot.hex() << ": " << value.hex() << endl;
 }
 
 void InterpreterState::dumpTraceAndState(ostream& _out) const
@@ -61,12 +150,8 @@ void InterpreterState::dumpTraceAndState(ostream& _out) const
 	for (auto const& line: trace)
 		_out << "  " << line << endl;
 	_out << "Memory dump:\n";
-	map<u256, u256> words;
-	for (auto const& [offset, value]: memory)
-		words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * static_cast<size_t>(offset % 0x20));
-	for (auto const& [offset, value]: words)
-		if (value != 0)
-			_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
+	for (auto const& [offset, value]: memory.nonZeroWords())
+		_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
 	_out << "Storage dump:" << endl;
 	dumpStorage(_out);
 }
@@ -30,6 +30,7 @@
 #include <libsolutil/Exceptions.h>
 
 #include <map>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -67,14 +68,46 @@ enum class ControlFlowState
 	Leave
 };
 
+/**
+ * Byte-addressed memory of the interpreter. Memory below ContiguousLimit is stored
+ * contiguously and grows on demand, bytes beyond that are stored sparsely.
+ * Bytes that have never been written read as zero.
+ */
+class InterpreterMemory
+{
+public:
+	uint8_t get(u256 const& _offset) const;
+	void set(u256 const& _offset, uint8_t _value);
+	/// @returns @a _size bytes starting at @a _offset, wrapping around at the end of the address space.
+	bytes read(u256 const& _offset, size_t _size) const;
+	/// Writes @a _size bytes starting at @a _offset, wrapping around at the end of the address space.
+	void write(u256 const& _offset, uint8_t const* _data, size_t _size);
+	void write(u256 const& _offset, bytes const& _data) { write(_offset, _data.data(), _data.size()); }
+
+	/// @returns the non-zero 32-byte words of the memory by their offset.
+	std::map<u256, u256> nonZeroWords() const;
+
+private:
+	static constexpr size_t ContiguousLimit = 0x100000;
+
+	bytes m_contiguous;
+	std::map<u256, uint8_t> m_sparse;
+};
+
+struct H256Hash
+{
+	size_t operator()(util::h256 const& _value) const;
+};
+
 struct InterpreterState
 {
 	bytes calldata;
 	bytes returndata;
-	std::map<u256, uint8_t> memory;
+	InterpreterMemory memory;
 	/// This is different than memory.size() because we ignore gas.
 	u256 msize;
-	std::map<util::h256, util::h256> storage;
+	/// Storage is printed sorted by slot, so the iteration order does not matter.
+	std::unordered_map<util::h256, util::h256, H256Hash> storage;
 	util::h160 address = util::h160("0x0000000000000000000000000000000011111111");
 	u256 balance = 0x22222222;
 	u256 selfbalance = 0x22223333;